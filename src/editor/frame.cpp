@@ -7,12 +7,9 @@
 #include "frame.hpp"
 
 // Qt include.
-#include <QApplication>
 #include <QMouseEvent>
 #include <QPainter>
 #include <QResizeEvent>
-#include <QRunnable>
-#include <QThreadPool>
 
 //
 // FramePrivate
@@ -33,6 +30,8 @@ public:
 
     //! Create thumbnail.
     void createThumbnail(int height);
+    //! \return Size of shown thumbnail or placeholder.
+    QSize thumbnailSize() const;
     //! Frame widget was resized.
     void resized(int height = -1);
 
@@ -40,6 +39,8 @@ public:
     ImageRef m_image;
     //! Thumbnail.
     QImage m_thumbnail;
+    //! Size of placeholder shown till thumbnail is ready.
+    QSize m_placeholder;
     //! Resize mode.
     Frame::ResizeMode m_mode;
     //! Dirty frame. We need to resize the image to actual size before drawing.
@@ -54,47 +55,6 @@ public:
     Frame *m_q;
 }; // class FramePrivate
 
-class ThumbnailCreator final : public QRunnable
-{
-public:
-    ThumbnailCreator(QImage img,
-                     int width,
-                     int height,
-                     int desiredHeight,
-                     Frame::ResizeMode mode)
-        : m_img(img)
-        , m_width(width)
-        , m_height(height)
-        , m_desiredHeight(desiredHeight)
-        , m_mode(mode)
-    {
-        setAutoDelete(false);
-    }
-
-    const QImage &image() const
-    {
-        return m_thumbnail;
-    }
-
-    void run() override
-    {
-        if (m_img.width() > m_width || m_img.height() > m_height) {
-            m_thumbnail =
-                m_img.scaledToHeight(m_desiredHeight > 0 ? m_desiredHeight : m_height, Qt::SmoothTransformation);
-        } else {
-            m_thumbnail = m_img;
-        }
-    }
-
-private:
-    QImage m_img;
-    int m_width;
-    int m_height;
-    int m_desiredHeight;
-    Frame::ResizeMode m_mode;
-    QImage m_thumbnail;
-};
-
 void FramePrivate::createThumbnail(int height)
 {
     m_dirty = false;
@@ -105,15 +65,11 @@ void FramePrivate::createThumbnail(int height)
         m_desiredHeight = height;
 
         if (m_mode == Frame::ResizeMode::FitToHeight) {
-            ThumbnailCreator c(m_image.m_gif.at(m_image.m_pos), m_q->width(), m_q->height(), height, m_mode);
-
-            QThreadPool::globalInstance()->start(&c);
-
-            while (!QThreadPool::globalInstance()->waitForDone(5)) {
-                QApplication::processEvents();
-            }
+            // Thumbnail is set by the tape when it's ready, size of the frame is known without decoding.
+            const auto h = m_q->thumbnailHeight();
+            const auto s = m_image.m_gif.size(m_image.m_pos);
 
-            m_thumbnail = c.image();
+            m_placeholder = (s.height() > h && h > 0 ? QSize(s.width() * h / s.height(), h) : s);
         } else {
             const auto img = m_image.m_gif.at(m_image.m_pos);
 
@@ -126,6 +82,11 @@ void FramePrivate::createThumbnail(int height)
     }
 }
 
+QSize FramePrivate::thumbnailSize() const
+{
+    return (m_thumbnail.isNull() ? m_placeholder : m_thumbnail.size());
+}
+
 void FramePrivate::resized(int height)
 {
     if (m_dirty || height != m_desiredHeight || m_q->width() != m_width || m_q->height() != m_height) {
@@ -174,6 +135,7 @@ const ImageRef &Frame::image() const
 void Frame::setImagePos(qsizetype pos)
 {
     m_d->m_image.m_pos = pos;
+    m_d->m_thumbnail = QImage();
     m_d->m_desiredHeight = -1;
     m_d->m_width = 0;
     m_d->m_height = 0;
@@ -185,6 +147,7 @@ void Frame::clearImage()
 {
     m_d->m_image.m_isEmpty = true;
     m_d->m_thumbnail = QImage();
+    m_d->m_placeholder = QSize();
     m_d->m_desiredHeight = -1;
     m_d->m_width = 0;
     m_d->m_height = 0;
@@ -200,23 +163,37 @@ void Frame::applyImage()
     update();
 }
 
-QRect Frame::thumbnailRect() const
+bool Frame::hasThumbnail() const
+{
+    return !m_d->m_thumbnail.isNull();
+}
+
+void Frame::setThumbnail(const QImage &img)
+{
+    m_d->m_thumbnail = img;
+
+    updateGeometry();
+    update();
+}
+
+int Frame::thumbnailHeight() const
 {
-    const int x = (width() - m_d->m_thumbnail.width()) / 2;
-    const int y = (height() - m_d->m_thumbnail.height()) / 2;
+    return (m_d->m_desiredHeight > 0 ? m_d->m_desiredHeight : height());
+}
 
-    QRect r = m_d->m_thumbnail.rect();
-    r.moveTopLeft(QPoint(x, y));
+QRect Frame::thumbnailRect() const
+{
+    const auto s = m_d->thumbnailSize();
+    const int x = (width() - s.width()) / 2;
+    const int y = (height() - s.height()) / 2;
 
-    return r;
+    return QRect(QPoint(x, y), s);
 }
 
 QRect Frame::imageRect() const
 {
     if (!m_d->m_image.m_isEmpty) {
-        const auto img = m_d->m_image.m_gif.at(m_d->m_image.m_pos);
-
-        return QRect(0, 0, img.width(), img.height());
+        return QRect(QPoint(), m_d->m_image.m_gif.size(m_d->m_image.m_pos));
     } else {
         return {};
     }
@@ -224,7 +201,9 @@ QRect Frame::imageRect() const
 
 QSize Frame::sizeHint() const
 {
-    return (m_d->m_thumbnail.isNull() ? QSize(10, 10) : m_d->m_thumbnail.size());
+    const auto s = m_d->thumbnailSize();
+
+    return (s.isValid() ? s : QSize(10, 10));
 }
 
 void Frame::paintEvent(QPaintEvent *)
@@ -234,13 +213,18 @@ void Frame::paintEvent(QPaintEvent *)
     }
 
     QPainter p(this);
-    p.drawImage(thumbnailRect(), m_d->m_thumbnail, m_d->m_thumbnail.rect());
+
+    if (!m_d->m_thumbnail.isNull()) {
+        p.drawImage(thumbnailRect(), m_d->m_thumbnail, m_d->m_thumbnail.rect());
+    } else if (m_d->m_placeholder.isValid()) {
+        p.fillRect(thumbnailRect(), palette().color(QPalette::Mid));
+    }
 }
 
 void Frame::resizeEvent(QResizeEvent *e)
 {
     if (m_d->m_mode == ResizeMode::FitToSize
-        || (m_d->m_mode == ResizeMode::FitToHeight && e->size().height() != m_d->m_thumbnail.height())) {
+        || (m_d->m_mode == ResizeMode::FitToHeight && e->size().height() != m_d->thumbnailSize().height())) {
         m_d->m_dirty = true;
     }
 
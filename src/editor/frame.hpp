@@ -10,8 +10,8 @@
 #include <QScopedPointer>
 #include <QWidget>
 
-// qgiflib include.
-#include <qgiflib.hpp>
+// GIF editor include.
+#include "frames.hpp"
 
 //
 // ImageRef
@@ -19,7 +19,7 @@
 
 //! Reference to full image.
 struct ImageRef final {
-    QGifLib::Gif &m_gif;
+    Frames &m_gif;
     qsizetype m_pos;
     bool m_isEmpty;
 }; // struct ImageRef
@@ -66,6 +66,12 @@ public:
     void clearImage();
     //! Apply image.
     void applyImage();
+    //! \return Is thumbnail ready.
+    bool hasThumbnail() const;
+    //! Set thumbnail made outside, used in FitToHeight mode.
+    void setThumbnail(const QImage &img);
+    //! \return Height of thumbnail.
+    int thumbnailHeight() const;
     //! \return Thumbnail image rect.
     QRect thumbnailRect() const;
     //! \return Image rect.
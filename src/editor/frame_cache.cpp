@@ -0,0 +1,112 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF editor include.
+#include "frame_cache.hpp"
+
+// Qt include.
+#include <QMutexLocker>
+
+namespace /* anonymous */
+{
+
+//! \return Cost of the image in the cache, in kilobytes.
+qsizetype cost(const QImage &img)
+{
+    return qMax<qsizetype>(1, img.sizeInBytes() / 1024);
+}
+
+} /* namespace anonymous */
+
+//
+// FrameCache
+//
+
+FrameCache::FrameCache(int budget)
+    : m_frames(static_cast<qsizetype>(budget) * 1024)
+{
+}
+
+int FrameCache::budget() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return static_cast<int>(m_frames.maxCost() / 1024);
+}
+
+void FrameCache::setBudget(int megabytes)
+{
+    QMutexLocker lock(&m_mutex);
+
+    m_frames.setMaxCost(static_cast<qsizetype>(qMax(0, megabytes)) * 1024);
+}
+
+QImage FrameCache::find(qsizetype idx) const
+{
+    QMutexLocker lock(&m_mutex);
+
+    // Lookup moves the frame to the head of the queue.
+    const auto img = m_frames.object(idx);
+
+    if (img) {
+        ++m_hits;
+
+        return *img;
+    }
+
+    ++m_misses;
+
+    return {};
+}
+
+void FrameCache::insert(qsizetype idx,
+                        const QImage &img)
+{
+    QMutexLocker lock(&m_mutex);
+
+    if (img.isNull()) {
+        m_frames.remove(idx);
+    } else {
+        // Frame bigger than the budget isn't cached.
+        m_frames.insert(idx, new QImage(img), cost(img));
+    }
+}
+
+void FrameCache::remove(qsizetype idx)
+{
+    QMutexLocker lock(&m_mutex);
+
+    m_frames.remove(idx);
+}
+
+void FrameCache::clear()
+{
+    QMutexLocker lock(&m_mutex);
+
+    m_frames.clear();
+    m_hits = 0;
+    m_misses = 0;
+}
+
+quint64 FrameCache::hits() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return m_hits;
+}
+
+quint64 FrameCache::misses() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return m_misses;
+}
+
+qint64 FrameCache::memoryUsage() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return static_cast<qint64>(m_frames.totalCost()) * 1024;
+}
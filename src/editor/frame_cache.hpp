@@ -0,0 +1,62 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QCache>
+#include <QImage>
+#include <QMutex>
+
+//
+// FrameCache
+//
+
+//! Cache of decoded frames with the memory budget, the least recently used frames
+//! are dropped when the budget is exceeded. Thread-safe.
+class FrameCache final
+{
+public:
+    //! Default memory budget, in megabytes.
+    static constexpr int s_defaultBudget = 256;
+
+    //! \a budget is in megabytes.
+    explicit FrameCache(int budget = s_defaultBudget);
+    ~FrameCache() = default;
+
+    //! \return Memory budget, in megabytes.
+    int budget() const;
+    //! Set memory budget in megabytes, frames above it are dropped.
+    void setBudget(int megabytes);
+
+    //! \return Frame at the given index, null if it's not cached.
+    QImage find(qsizetype idx) const;
+    //! Put frame at the given index to the cache.
+    void insert(qsizetype idx,
+                const QImage &img);
+    //! Drop frame at the given index.
+    void remove(qsizetype idx);
+    //! Drop all frames and reset counters.
+    void clear();
+
+    //! \return Count of frames found in the cache.
+    quint64 hits() const;
+    //! \return Count of frames not found in the cache.
+    quint64 misses() const;
+    //! \return Memory used by cached frames, in bytes.
+    qint64 memoryUsage() const;
+
+private:
+    Q_DISABLE_COPY(FrameCache)
+
+    //! Guard.
+    mutable QMutex m_mutex;
+    //! Frames by index, cost is in kilobytes.
+    QCache<qsizetype, QImage> m_frames;
+    //! Count of frames found in the cache.
+    mutable quint64 m_hits = 0;
+    //! Count of frames not found in the cache.
+    mutable quint64 m_misses = 0;
+}; // class FrameCache
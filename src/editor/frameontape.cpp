@@ -6,6 +6,7 @@
 // GIF editor include.
 #include "frameontape.hpp"
 #include "delay.hpp"
+#include "tape.hpp"
 
 // Qt include.
 #include <QCheckBox>
@@ -14,6 +15,7 @@
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QMenu>
+#include <QSignalBlocker>
 #include <QVBoxLayout>
 
 //
@@ -64,6 +66,8 @@ public:
     Frame *m_frame;
     //! Modified lable.
     QLabel *m_modifiedLabel;
+    //! Shown item.
+    TapeItem *m_item = nullptr;
     //! Parent.
     FrameOnTape *m_q;
 }; // class FrameOnTapePrivate
@@ -129,6 +133,34 @@ FrameOnTape::~FrameOnTape() noexcept
 {
 }
 
+TapeItem *FrameOnTape::item() const
+{
+    return m_d->m_item;
+}
+
+void FrameOnTape::setItem(TapeItem *item)
+{
+    m_d->m_item = item;
+
+    if (item) {
+        setCounter(item->counter());
+        setCurrent(item->isCurrent());
+        setModified(item->isModified());
+
+        {
+            // Item already knows its state.
+            QSignalBlocker blocker(m_d->m_checkBox);
+
+            setChecked(item->isChecked());
+        }
+
+        if (image().m_isEmpty || image().m_pos != item->image().m_pos) {
+            setImagePos(item->image().m_pos);
+            applyImage();
+        }
+    }
+}
+
 const ImageRef &FrameOnTape::image() const
 {
     return m_d->m_frame->image();
@@ -149,6 +181,21 @@ void FrameOnTape::applyImage()
     m_d->m_frame->applyImage();
 }
 
+bool FrameOnTape::hasThumbnail() const
+{
+    return m_d->m_frame->hasThumbnail();
+}
+
+void FrameOnTape::setThumbnail(const QImage &img)
+{
+    m_d->m_frame->setThumbnail(img);
+}
+
+int FrameOnTape::thumbnailHeight() const
+{
+    return m_d->m_frame->thumbnailHeight();
+}
+
 bool FrameOnTape::isChecked() const
 {
     return m_d->m_checkBox->isChecked();
@@ -13,13 +13,15 @@
 // GIF editor include.
 #include "frame.hpp"
 
+class TapeItem;
+
 //
 // FrameOnTape
 //
 
 class FrameOnTapePrivate;
 
-//! Frame on tape.
+//! Frame on tape. Widget shows the item of the tape and may be reused for another one.
 class FrameOnTape final : public QFrame
 {
     Q_OBJECT
@@ -43,6 +45,11 @@ public:
                 QWidget *parent = nullptr);
     ~FrameOnTape() noexcept override;
 
+    //! \return Shown item.
+    TapeItem *item() const;
+    //! Show the item.
+    void setItem(TapeItem *item);
+
     //! \return Image.
     const ImageRef &image() const;
     //! Set image.
@@ -51,6 +58,12 @@ public:
     void clearImage();
     //! Apply image.
     void applyImage();
+    //! \return Is thumbnail ready.
+    bool hasThumbnail() const;
+    //! Set thumbnail.
+    void setThumbnail(const QImage &img);
+    //! \return Height of thumbnail.
+    int thumbnailHeight() const;
 
     //! \return Is frame checked.
     bool isChecked() const;
@@ -0,0 +1,500 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF editor include.
+#include "frames.hpp"
+
+// Qt include.
+#include <QDir>
+#include <QFile>
+#include <QHashFunctions>
+#include <QImageReader>
+#include <QMutexLocker>
+
+namespace /* anonymous */
+{
+
+//! \return Hash of the data, never 0.
+size_t contentHash(const void *data,
+                   qsizetype size)
+{
+    const auto h = qHashBits(data, static_cast<size_t>(size), 0);
+
+    return (h ? h : 1);
+}
+
+//! \return Disposal method of Graphic Control Extension.
+FrameInfo::Disposal gifDisposal(uchar flags)
+{
+    switch ((flags >> 2) & 0x07) {
+    case 1:
+        return FrameInfo::Keep;
+
+    case 2:
+        return FrameInfo::Background;
+
+    case 3:
+        return FrameInfo::Previous;
+
+    default:
+        return FrameInfo::Unspecified;
+    }
+}
+
+//! \return Offsets and disposal methods of frames of GIF, read from blocks of the file
+//! without decoding. Empty on error.
+QVector<FrameInfo> scanGif(const QString &fileName)
+{
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+
+    const auto size = file.size();
+    const uchar *data = file.map(0, size);
+
+    // Header and logical screen descriptor.
+    if (!data || size < 13 || (qstrncmp(reinterpret_cast<const char *>(data), "GIF87a", 6) != 0
+                               && qstrncmp(reinterpret_cast<const char *>(data), "GIF89a", 6) != 0)) {
+        return {};
+    }
+
+    qint64 pos = 13;
+
+    const auto skipColorTable = [&pos](uchar flags) {
+        if (flags & 0x80) {
+            pos += 3 * (1 << ((flags & 0x07) + 1));
+        }
+    };
+
+    const auto skipSubBlocks = [&pos, data, size]() {
+        while (pos < size) {
+            const auto bytes = data[pos++];
+
+            if (!bytes) {
+                return true;
+            }
+
+            pos += bytes;
+        }
+
+        return false;
+    };
+
+    skipColorTable(data[10]);
+
+    QVector<FrameInfo> frames;
+    FrameInfo next;
+
+    while (pos < size) {
+        const auto start = pos;
+
+        switch (data[pos++]) {
+        // Extension.
+        case 0x21: {
+            if (pos + 1 >= size) {
+                return {};
+            }
+
+            // Graphic Control Extension belongs to the next image.
+            if (data[pos] == 0xF9 && pos + 2 < size) {
+                next.m_disposal = gifDisposal(data[pos + 2]);
+                next.m_offset = start;
+            }
+
+            ++pos;
+
+            if (!skipSubBlocks()) {
+                return {};
+            }
+        } break;
+
+        // Image descriptor.
+        case 0x2C: {
+            if (pos + 10 > size) {
+                return {};
+            }
+
+            if (next.m_offset < 0) {
+                next.m_offset = start;
+            }
+
+            const auto flags = data[pos + 8];
+            // Descriptor and minimum size of LZW code.
+            pos += 10;
+            skipColorTable(flags);
+
+            if (!skipSubBlocks()) {
+                return {};
+            }
+
+            frames.push_back(next);
+            next = {};
+        } break;
+
+        // Trailer.
+        case 0x3B:
+            return frames;
+
+        default:
+            return {};
+        }
+    }
+
+    return {};
+}
+
+} /* namespace anonymous */
+
+//
+// Frames
+//
+
+Frames::Frames(const QString &path)
+    : m_path(path)
+    , m_gif(path)
+{
+}
+
+Frames::~Frames()
+{
+    clean();
+}
+
+bool Frames::load(const QString &fileName)
+{
+    clean();
+
+    if (!ProjectReader::isProject(fileName)) {
+        if (!m_gif.load(fileName)) {
+            return false;
+        }
+
+        initGif(fileName);
+
+        return true;
+    }
+
+    if (!m_project.open(fileName)) {
+        return false;
+    }
+
+    initProject();
+
+    return true;
+}
+
+bool Frames::loadShared(const QString &name)
+{
+    clean();
+
+    if (!m_project.openShared(name)) {
+        return false;
+    }
+
+    initProject();
+
+    return true;
+}
+
+void Frames::initGif(const QString &fileName)
+{
+    const auto files = m_gif.fileNames();
+    auto blocks = scanGif(fileName);
+
+    // Blocks don't match frames of the file, GIF is read with errors.
+    if (blocks.size() != m_gif.count()) {
+        blocks.clear();
+    }
+
+    QMutexLocker lock(&m_mutex);
+
+    m_index.reserve(m_gif.count());
+
+    for (qsizetype i = 0; i < m_gif.count(); ++i) {
+        auto info = blocks.value(i);
+        // Only the header of PNG is read.
+        info.m_size = QImageReader(files.value(i)).size();
+        info.m_delay = m_gif.delay(i);
+
+        m_index.push_back(info);
+    }
+
+    m_timestamps.resize(m_index.size());
+}
+
+void Frames::initProject()
+{
+    QDir().mkpath(m_path);
+
+    QMutexLocker lock(&m_mutex);
+
+    m_index.reserve(m_project.count());
+
+    for (qsizetype i = 0; i < m_project.count(); ++i) {
+        FrameInfo info;
+        info.m_size = m_project.size();
+        info.m_delay = m_project.delay(i);
+        info.m_disposal = FrameInfo::Keep;
+        info.m_offset = m_project.offset(i);
+
+        m_index.push_back(info);
+        m_fileNames.push_back({});
+    }
+
+    m_timestamps.resize(m_index.size());
+}
+
+bool Frames::isProject() const
+{
+    return m_project.isOpen();
+}
+
+qsizetype Frames::count() const
+{
+    return (isProject() ? m_project.count() : m_gif.count());
+}
+
+QImage Frames::at(qsizetype idx) const
+{
+    while (true) {
+        auto img = m_cache.find(idx);
+
+        if (!img.isNull()) {
+            return img;
+        }
+
+        quint64 generation = 0;
+        QString fileName;
+
+        {
+            QMutexLocker lock(&m_mutex);
+
+            if (idx < 0 || idx >= m_index.size()) {
+                return {};
+            }
+
+            generation = m_index[idx].m_generation;
+            fileName = m_fileNames.value(idx);
+        }
+
+        if (!isProject()) {
+            img = m_gif.at(idx);
+        } else {
+            img = (fileName.isEmpty() ? m_project.frame(idx) : QImage(fileName));
+        }
+
+        QMutexLocker lock(&m_mutex);
+
+        // Frame was changed while it was decoded, decoded one is stale or even torn.
+        if (idx < m_index.size() && m_index[idx].m_generation == generation) {
+            m_cache.insert(idx, img);
+
+            return img;
+        }
+    }
+}
+
+FrameInfo Frames::info(qsizetype idx) const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return m_index.value(idx);
+}
+
+QSize Frames::size(qsizetype idx) const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return (idx >= 0 && idx < m_index.size() ? m_index[idx].m_size : QSize());
+}
+
+bool Frames::isModified(qsizetype idx) const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return (idx >= 0 && idx < m_index.size() ? m_index[idx].m_modified : false);
+}
+
+size_t Frames::hash(qsizetype idx) const
+{
+    {
+        QMutexLocker lock(&m_mutex);
+
+        if (idx < 0 || idx >= m_index.size()) {
+            return 0;
+        }
+
+        if (m_index[idx].m_hash) {
+            return m_index[idx].m_hash;
+        }
+    }
+
+    // Hash of the compressed frame is calculated on demand, it's cheaper than decoding,
+    // but reading the whole file on load isn't free.
+    size_t h = 0;
+
+    if (isProject()) {
+        const auto data = m_project.data(idx);
+
+        h = contentHash(data.constData(), data.size());
+    } else {
+        QFile file(m_gif.fileNames().value(idx));
+
+        if (file.open(QIODevice::ReadOnly)) {
+            const auto data = file.readAll();
+
+            h = contentHash(data.constData(), data.size());
+        }
+    }
+
+    QMutexLocker lock(&m_mutex);
+
+    // Frame may be changed meanwhile.
+    if (!m_index[idx].m_hash) {
+        m_index[idx].m_hash = h;
+    }
+
+    return m_index[idx].m_hash;
+}
+
+int Frames::delay(qsizetype idx) const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return (idx >= 0 && idx < m_index.size() ? m_index[idx].m_delay : 0);
+}
+
+qint64 Frames::timestamp(qsizetype idx) const
+{
+    QMutexLocker lock(&m_mutex);
+
+    if (idx < 0 || idx >= m_index.size()) {
+        return 0;
+    }
+
+    for (; m_validTimestamps <= idx; ++m_validTimestamps) {
+        const auto i = m_validTimestamps;
+
+        m_timestamps[i] = (i ? m_timestamps[i - 1] + m_index[i - 1].m_delay : 0);
+    }
+
+    return m_timestamps[idx];
+}
+
+void Frames::setDelay(qsizetype idx,
+                      int delay)
+{
+    if (!isProject()) {
+        m_gif.setDelay(idx, delay);
+    }
+
+    QMutexLocker lock(&m_mutex);
+
+    if (idx >= 0 && idx < m_index.size()) {
+        m_index[idx].m_delay = delay;
+        m_validTimestamps = qMin(m_validTimestamps, idx + 1);
+    }
+}
+
+void Frames::setImage(qsizetype idx,
+                      const QImage &img)
+{
+    {
+        QMutexLocker lock(&m_mutex);
+
+        if (idx < 0 || idx >= m_index.size()) {
+            return;
+        }
+
+        auto &info = m_index[idx];
+        info.m_size = img.size();
+        info.m_hash = contentHash(img.constBits(), img.sizeInBytes());
+        info.m_modified = true;
+        ++info.m_generation;
+
+        m_cache.insert(idx, img);
+    }
+
+    if (!isProject()) {
+        img.save(m_gif.fileNames().at(idx));
+    } else {
+        writeProjectFrame(idx, img);
+    }
+
+    QMutexLocker lock(&m_mutex);
+
+    // Frames read while the file was written are dropped too.
+    ++m_index[idx].m_generation;
+}
+
+void Frames::writeProjectFrame(qsizetype idx,
+                               const QImage &img)
+{
+    const auto fileName = projectFileName(idx);
+
+    img.save(fileName);
+
+    QMutexLocker lock(&m_mutex);
+
+    m_fileNames[idx] = fileName;
+}
+
+QStringList Frames::fileNames()
+{
+    if (!isProject()) {
+        return m_gif.fileNames();
+    }
+
+    for (qsizetype i = 0; i < m_project.count(); ++i) {
+        bool written = false;
+
+        {
+            QMutexLocker lock(&m_mutex);
+
+            written = !m_fileNames.at(i).isEmpty();
+        }
+
+        // Frames written for GIF only don't go to the cache.
+        if (!written) {
+            writeProjectFrame(i, m_project.frame(i));
+        }
+    }
+
+    QMutexLocker lock(&m_mutex);
+
+    return m_fileNames;
+}
+
+void Frames::clean()
+{
+    m_gif.clean();
+    m_cache.clear();
+
+    QMutexLocker lock(&m_mutex);
+
+    for (const auto &fileName : std::as_const(m_fileNames)) {
+        if (!fileName.isEmpty()) {
+            QFile::remove(fileName);
+        }
+    }
+
+    m_fileNames.clear();
+    m_index.clear();
+    m_timestamps.clear();
+    m_validTimestamps = 0;
+    m_project.close();
+}
+
+FrameCache &Frames::cache()
+{
+    return m_cache;
+}
+
+QString Frames::projectFileName(qsizetype idx) const
+{
+    return QDir(m_path).filePath(QStringLiteral("project-%1.png").arg(idx));
+}
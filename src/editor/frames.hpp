@@ -0,0 +1,142 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QImage>
+#include <QMutex>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// qgiflib include.
+#include <qgiflib.hpp>
+
+// shared include.
+#include "project.hpp"
+
+// GIF editor include.
+#include "frame_cache.hpp"
+
+//
+// FrameInfo
+//
+
+//! Metadata of the frame, known without decoding it.
+struct FrameInfo {
+    //! Disposal method of GIF frame.
+    enum Disposal : quint8 {
+        //! Not specified.
+        Unspecified = 0,
+        //! Frame is left in place.
+        Keep,
+        //! Frame is replaced with the background.
+        Background,
+        //! Frame is replaced with the previous one.
+        Previous
+    }; // enum Disposal
+
+    //! Size.
+    QSize m_size;
+    //! Delay in milliseconds.
+    int m_delay = 0;
+    //! Disposal method.
+    Disposal m_disposal = Unspecified;
+    //! Offset of the frame in the file, -1 if it's unknown.
+    qint64 m_offset = -1;
+    //! Hash of the content, 0 if it isn't calculated yet.
+    size_t m_hash = 0;
+    //! Is frame changed since it was loaded.
+    bool m_modified = false;
+    //! Generation of the content, it's changed when the frame is changed.
+    quint64 m_generation = 0;
+}; // struct FrameInfo
+
+//
+// Frames
+//
+
+//! Frames of the opened file, GIF or the project of the recorder. Frames of the project
+//! are read from it directly without quantization, they are written to PNG files only
+//! when they are changed or when GIF is saved. Decoded frames are cached. Metadata of
+//! frames is indexed on load, so geometry and timings are known without decoding.
+class Frames final
+{
+public:
+    //! Files of frames are stored in the \a path directory.
+    explicit Frames(const QString &path);
+    ~Frames();
+
+    //! Load GIF or project. \return false on error.
+    bool load(const QString &fileName);
+    //! Load project from the shared memory segment of the recorder. \return false on error.
+    bool loadShared(const QString &name);
+    //! \return Is the project opened.
+    bool isProject() const;
+    //! \return Count of frames.
+    qsizetype count() const;
+    //! \return Frame at the given index.
+    QImage at(qsizetype idx) const;
+    //! \return Metadata of frame at the given index.
+    FrameInfo info(qsizetype idx) const;
+    //! \return Size of frame at the given index.
+    QSize size(qsizetype idx) const;
+    //! \return Is frame at the given index changed since it was loaded.
+    bool isModified(qsizetype idx) const;
+    //! \return Hash of the content of frame at the given index.
+    size_t hash(qsizetype idx) const;
+    //! \return Delay of frame at the given index, in milliseconds.
+    int delay(qsizetype idx) const;
+    //! \return Time of frame at the given index since the first one, in milliseconds.
+    qint64 timestamp(qsizetype idx) const;
+    //! Set delay of frame at the given index, in milliseconds.
+    void setDelay(qsizetype idx,
+                  int delay);
+    //! Replace frame at the given index. May be called from any thread, frames being
+    //! decoded meanwhile aren't cached.
+    void setImage(qsizetype idx,
+                  const QImage &img);
+    //! \return PNG files of all frames, frames of the project are written when they aren't yet.
+    QStringList fileNames();
+    //! Remove frames.
+    void clean();
+
+    //! \return Cache of decoded frames.
+    FrameCache &cache();
+
+private:
+    Q_DISABLE_COPY(Frames)
+
+    //! Index frames of the opened GIF.
+    void initGif(const QString &fileName);
+    //! Index frames of the opened project.
+    void initProject();
+    //! Write frame of the project at the given index to PNG file.
+    void writeProjectFrame(qsizetype idx,
+                           const QImage &img);
+    //! \return File name of the frame of the project at the given index.
+    QString projectFileName(qsizetype idx) const;
+
+    //! Directory of files of frames.
+    QString m_path;
+    //! Frames of GIF.
+    QGifLib::Gif m_gif;
+    //! Project.
+    ProjectReader m_project;
+    //! Metadata of frames.
+    mutable QVector<FrameInfo> m_index;
+    //! Times of frames, valid up to m_validTimestamps, the rest is calculated on demand.
+    mutable QVector<qint64> m_timestamps;
+    //! Count of valid times of frames.
+    mutable qsizetype m_validTimestamps = 0;
+    //! Files of changed frames of the project, empty if frame is read from the project.
+    QStringList m_fileNames;
+    //! Guard of metadata and files of frames of the project.
+    mutable QMutex m_mutex;
+    //! Decoded frames.
+    mutable FrameCache m_cache;
+}; // class Frames
@@ -64,6 +64,11 @@ int main(int argc,
     parser.addHelpOption();
     parser.addPositionalArgument(QStringLiteral("gif"), QStringLiteral("GIF file to open."));
 
+    const QCommandLineOption sharedOption(QStringLiteral("shared"),
+                                          QStringLiteral("Shared memory segment with frames from GIF recorder."),
+                                          QStringLiteral("name"));
+    parser.addOption(sharedOption);
+
     parser.process(app);
 
     const auto args = parser.positionalArguments();
@@ -74,7 +79,9 @@ int main(int argc,
     w.resize(800, 600);
     w.show();
 
-    if (!fileName.isEmpty()) {
+    if (parser.isSet(sharedOption)) {
+        w.openShared(parser.value(sharedOption), true);
+    } else if (!fileName.isEmpty()) {
         w.openFile(fileName, true);
     }
 
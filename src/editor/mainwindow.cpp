@@ -35,6 +35,9 @@
 #include <QWindow>
 #include <QtConcurrent>
 
+// shared include.
+#include "project.hpp"
+
 // gif-widgets include.
 #include "license_dialog.hpp"
 #include "utils.hpp"
@@ -51,10 +54,20 @@ namespace /* anonymous */
 
 void writeGIFFunc(QPromise<void> &,
                   BusyIndicator *receiver,
-                  const QStringList &files,
+                  Frames *container,
+                  const QVector<qsizetype> &frames,
                   const QVector<int> &delays,
                   const QString &fileName)
 {
+    // Frames of the project are written to PNG files only now.
+    const auto allFiles = container->fileNames();
+    QStringList files;
+    files.reserve(frames.size());
+
+    for (const auto idx : frames) {
+        files.push_back(allFiles.at(idx));
+    }
+
     QGifLib::Gif gif;
 
     QObject::connect(&gif, &QGifLib::Gif::writeProgress, receiver, &BusyIndicator::setPercent);
@@ -64,19 +77,19 @@ void writeGIFFunc(QPromise<void> &,
 
 void cropGIFFunc(QPromise<void> &,
                  BusyIndicator *receiver,
-                 QGifLib::Gif *container,
+                 Frames *container,
                  const QRect &rect)
 {
     const auto index = receiver->metaObject()->indexOfProperty("percent");
     auto property = receiver->metaObject()->property(index);
 
     int current = 0;
-    const auto count = container->fileNames().size();
+    const auto count = container->count();
 
     property.write(receiver, 0);
 
-    for (const auto &fileName : container->fileNames()) {
-        QImage(fileName).copy(rect).save(fileName);
+    for (qsizetype idx = 0; idx < count; ++idx) {
+        container->setImage(idx, container->at(idx).copy(rect));
         ++current;
         property.write(receiver, qRound(((double)current / (double)count) * 100.0));
     }
@@ -86,7 +99,7 @@ void cropGIFFunc(QPromise<void> &,
 
 void applyTextFunc(QPromise<void> &,
                    BusyIndicator *receiver,
-                   QGifLib::Gif *container,
+                   Frames *container,
                    const QRect &rect,
                    const TextFrame::Documents &docs,
                    const QVector<qsizetype> &unchecked)
@@ -96,13 +109,12 @@ void applyTextFunc(QPromise<void> &,
 
     int current = 0;
     const auto count = docs.size();
-    const auto fileNames = container->fileNames();
 
     property.write(receiver, 0);
 
     for (const auto idx : docs.keys()) {
         if (!unchecked.contains(idx + 1)) {
-            QImage img(fileNames.at(idx));
+            auto img = container->at(idx);
             QPainter p(&img);
             QTextDocument *doc = docs[idx]->clone();
             doc->setPageSize(rect.size().toSizeF());
@@ -110,7 +122,7 @@ void applyTextFunc(QPromise<void> &,
             p.translate(rect.topLeft());
             doc->drawContents(&p);
             doc->deleteLater();
-            img.save(fileNames.at(idx));
+            container->setImage(idx, img);
         }
 
         ++current;
@@ -122,7 +134,7 @@ void applyTextFunc(QPromise<void> &,
 
 void applyRectFunc(QPromise<void> &,
                    BusyIndicator *receiver,
-                   QGifLib::Gif *container,
+                   Frames *container,
                    const QRect &rect,
                    const QSet<qsizetype> &frames,
                    const QVector<qsizetype> &unchecked)
@@ -132,16 +144,15 @@ void applyRectFunc(QPromise<void> &,
 
     int current = 0;
     const auto count = frames.size();
-    const auto fileNames = container->fileNames();
 
     property.write(receiver, 0);
 
     for (const auto idx : std::as_const(frames)) {
         if (!unchecked.contains(idx + 1)) {
-            QImage img(fileNames.at(idx));
+            auto img = container->at(idx);
             QPainter p(&img);
             RectFrame::drawRect(p, rect);
-            img.save(fileNames.at(idx));
+            container->setImage(idx, img);
         }
 
         ++current;
@@ -153,7 +164,7 @@ void applyRectFunc(QPromise<void> &,
 
 void applyArrowFunc(QPromise<void> &,
                     BusyIndicator *receiver,
-                    QGifLib::Gif *container,
+                    Frames *container,
                     const QRect &rect,
                     ArrowFrame::Orientation o,
                     const QSet<qsizetype> &frames,
@@ -164,16 +175,15 @@ void applyArrowFunc(QPromise<void> &,
 
     int current = 0;
     const auto count = frames.size();
-    const auto fileNames = container->fileNames();
 
     property.write(receiver, 0);
 
     for (const auto idx : std::as_const(frames)) {
         if (!unchecked.contains(idx + 1)) {
-            QImage img(fileNames.at(idx));
+            auto img = container->at(idx);
             QPainter p(&img);
             ArrowFrame::drawArrow(p, rect, o);
-            img.save(fileNames.at(idx));
+            container->setImage(idx, img);
         }
 
         ++current;
@@ -197,6 +207,8 @@ MainWindow::MainWindow()
 
 MainWindow::~MainWindow() noexcept
 {
+    // Thumbnails are made from frames in the background, frames are destroyed before the tape.
+    m_d->m_view->tape()->clear();
 }
 
 void MainWindow::initUi()
@@ -611,7 +623,11 @@ void MainWindow::showEvent(QShowEvent *e)
             showMaximized();
         }
 
-        if (!m_d->m_fileNameToOpenAfterShow.isEmpty()) {
+        if (!m_d->m_sharedToOpenAfterShow.isEmpty()) {
+            QTimer::singleShot(0, [this]() {
+                this->openShared(this->m_d->m_sharedToOpenAfterShow);
+            });
+        } else if (!m_d->m_fileNameToOpenAfterShow.isEmpty()) {
             QTimer::singleShot(0, [this]() {
                 this->openFile(this->m_d->m_fileNameToOpenAfterShow);
             });
@@ -632,7 +648,9 @@ void MainWindow::openFile(const QString &fileName,
         return;
     }
 
-    if (!fileName.isEmpty() && QFileInfo(fileName).suffix().toLower() == QStringLiteral("gif")) {
+    const auto suffix = QFileInfo(fileName).suffix().toLower();
+
+    if (!fileName.isEmpty() && (suffix == QStringLiteral("gif") || suffix == projectSuffix())) {
         if (isWindowModified()) {
             const auto btn = QMessageBox::question(this,
                                                    tr("GIF was changed..."),
@@ -649,6 +667,20 @@ void MainWindow::openFile(const QString &fileName,
     }
 }
 
+void MainWindow::openShared(const QString &name,
+                            bool afterShowEvent)
+{
+    if (afterShowEvent && !m_d->m_shownAlready) {
+        m_d->m_sharedToOpenAfterShow = name;
+
+        return;
+    }
+
+    if (!name.isEmpty()) {
+        m_d->openShared(name);
+    }
+}
+
 void MainWindow::openGif()
 {
     static const auto pictureLocations = QStandardPaths::standardLocations(QStandardPaths::PicturesLocation);
@@ -657,23 +689,27 @@ void MainWindow::openGif()
         QFileDialog::getOpenFileName(this,
                                      tr("Open GIF..."),
                                      (!pictureLocations.isEmpty() ? pictureLocations.first() : QString()),
-                                     tr("GIF (*.gif)"));
+                                     tr("GIF (*.gif);;GIF recorder project (*.%1)").arg(projectSuffix()));
 
     openFile(fileName);
 }
 
-void MainWindow::saveGif()
+bool MainWindow::saveGif()
 {
+    // Project is never overwritten, GIF is saved besides it.
+    if (QFileInfo(m_d->m_currentGif).suffix().toLower() == projectSuffix()) {
+        return saveGifAs();
+    }
+
     try {
         emit saveFileTriggered();
 
-        QStringList toSave;
+        QVector<qsizetype> toSave;
         QVector<int> delays;
-        const auto allFiles = m_d->m_frames.fileNames();
 
         for (int i = 0; i < m_d->m_view->tape()->count(); ++i) {
             if (m_d->m_view->tape()->frame(i + 1)->isChecked()) {
-                toSave.push_back(allFiles.at(i));
+                toSave.push_back(i);
                 delays.push_back(m_d->m_frames.delay(i));
             }
         }
@@ -683,8 +719,15 @@ void MainWindow::saveGif()
             m_d->m_busyStatusLabel->setText(tr("Saving GIF..."));
 
             connect(&m_d->m_watcher, &QFutureWatcher<void>::finished, this, qOverload<>(&MainWindow::gifSaved));
-            auto future = QtConcurrent::run(writeGIFFunc, m_d->m_busy, toSave, delays, m_d->m_currentGif);
+            auto future = QtConcurrent::run(writeGIFFunc,
+                                            m_d->m_busy,
+                                            &m_d->m_frames,
+                                            toSave,
+                                            delays,
+                                            m_d->m_currentGif);
             m_d->m_watcher.setFuture(future);
+
+            return true;
         } else {
             m_d->m_currentGif = m_d->m_oldGif;
 
@@ -699,9 +742,11 @@ void MainWindow::saveGif()
 
         QMessageBox::critical(this, tr("Failed to save GIF..."), tr("Out of memory."));
     }
+
+    return false;
 }
 
-void MainWindow::saveGifAs()
+bool MainWindow::saveGifAs()
 {
     auto fileName = QFileDialog::getSaveFileName(this, tr("Choose file to save to..."), QString(), tr("GIF (*.gif)"));
 
@@ -713,8 +758,10 @@ void MainWindow::saveGifAs()
         m_d->m_oldGif = m_d->m_currentGif;
         m_d->m_currentGif = fileName;
 
-        saveGif();
+        return saveGif();
     }
+
+    return false;
 }
 
 void MainWindow::quit()
@@ -730,7 +777,10 @@ void MainWindow::quit()
             if (btn == QMessageBox::Yes) {
                 emit stopPlaying();
 
-                saveGif();
+                // Saving is cancelled or failed, changes aren't lost silently.
+                if (!saveGif()) {
+                    return;
+                }
 
                 delayQuit = true;
             }
@@ -810,6 +860,9 @@ void MainWindow::applyEdit()
 
             m_d->m_busy->setShowPercent(true);
 
+            // Thumbnails are made from frames being changed.
+            m_d->m_view->tape()->setThumbnailsEnabled(false);
+
             connect(&m_d->m_watcher, &QFutureWatcher<void>::finished, this, &MainWindow::gifCropped);
             auto future = QtConcurrent::run(cropGIFFunc, m_d->m_busy, &m_d->m_frames, rect);
             m_d->m_watcher.setFuture(future);
@@ -843,6 +896,9 @@ void MainWindow::applyEdit()
                 }
             }
 
+            // Thumbnails are made from frames being changed.
+            m_d->m_view->tape()->setThumbnailsEnabled(false);
+
             connect(&m_d->m_watcher, &QFutureWatcher<void>::finished, this, &MainWindow::graphicsApplied);
 
             switch (m_d->m_editMode) {
@@ -1006,6 +1062,9 @@ void MainWindow::applyText()
             }
         }
 
+        // Thumbnails are made from frames being changed.
+        m_d->m_view->tape()->setThumbnailsEnabled(false);
+
         connect(&m_d->m_watcher, &QFutureWatcher<void>::finished, this, &MainWindow::graphicsApplied);
         auto future = QtConcurrent::run(applyTextFunc,
                                         m_d->m_busy,
@@ -1023,7 +1082,10 @@ void MainWindow::onSettings()
 {
     SettingsDlg dlg(this);
 
-    dlg.exec();
+    if (dlg.exec() == QDialog::Accepted) {
+        m_d->m_frames.cache().setBudget(Settings::instance().frameCacheSize());
+        m_d->m_view->tape()->setThumbnailCacheSize(Settings::instance().thumbnailCacheSize());
+    }
 }
 
 void MainWindow::hidePenWidthSpinBox()
@@ -1102,12 +1164,23 @@ void MainWindow::gifLoaded()
     } else {
         emit fileLoadingFailed();
 
-        QMessageBox::critical(this,
-                              tr("Unable to load GIF..."),
-                              tr("Unable to load GIF file. File \"%1\" is corrupted.").arg(m_d->m_currentGif));
+        // There is no file behind frames passed by the recorder.
+        if (!m_d->m_sharedName.isEmpty()) {
+            QMessageBox::critical(this,
+                                  tr("Unable to load GIF..."),
+                                  tr("Unable to read frames passed by the recorder. Shared memory segment \"%1\" "
+                                     "is missing or corrupted.")
+                                      .arg(m_d->m_sharedName));
+        } else {
+            QMessageBox::critical(this,
+                                  tr("Unable to load GIF..."),
+                                  tr("Unable to load GIF file. File \"%1\" is corrupted.").arg(m_d->m_currentGif));
+        }
 
         m_d->m_currentGif.clear();
     }
+
+    m_d->m_sharedName.clear();
 }
 
 void MainWindow::gifSaved()
@@ -1138,6 +1211,7 @@ void MainWindow::gifCropped()
 
     m_d->initTape();
 
+    m_d->m_view->tape()->setThumbnailsEnabled(true);
     m_d->m_view->tape()->setCurrentFrame(current);
 
     for (const auto &i : std::as_const(m_d->m_unchecked)) {
@@ -1164,6 +1238,7 @@ void MainWindow::graphicsApplied()
 
     m_d->initTape();
 
+    m_d->m_view->tape()->setThumbnailsEnabled(true);
     m_d->m_view->tape()->setCurrentFrame(current);
 
     m_d->setModified(true);
@@ -1174,9 +1249,11 @@ void MainWindow::graphicsApplied()
 void MainWindow::onFrameSelected(int idx)
 {
     if (idx) {
+        const auto time = static_cast<int>(m_d->m_frames.timestamp(idx - 1));
+
         m_d->m_status->setText(
             tr("<b>Time:</b> %1 <b>Total Duration:</b> %2 <b>Current Frame:</b> #%3")
-                .arg(QTime::fromMSecsSinceStartOfDay(m_d->m_timings[idx - 1]).toString(QStringLiteral("hh:mm:ss.zzz")),
+                .arg(QTime::fromMSecsSinceStartOfDay(time).toString(QStringLiteral("hh:mm:ss.zzz")),
                      m_d->m_totalDuration,
                      QString::number(idx)));
 
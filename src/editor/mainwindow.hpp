@@ -40,16 +40,19 @@ public slots:
     //! Open GIF.
     void openFile(const QString &fileName,
                   bool afterShowEvent = false);
+    //! Open frames passed by GIF recorder through the shared memory segment.
+    void openShared(const QString &name,
+                    bool afterShowEvent = false);
 
 private slots:
     //! Hide pen width spin box.
     void hidePenWidthSpinBox();
     //! Open GIF.
     void openGif();
-    //! Save GIF.
-    void saveGif();
-    //! Save GIF as.
-    void saveGifAs();
+    //! Save GIF. \return Is saving started.
+    bool saveGif();
+    //! Save GIF as. \return Is saving started.
+    bool saveGifAs();
     //! Quit.
     void quit();
     //! Frame checked/unchecked.
@@ -7,11 +7,16 @@
 #include "mainwindow_private.hpp"
 #include "frameontape.hpp"
 #include "mainwindow.hpp"
+#include "settings.hpp"
 #include "tape.hpp"
 
+// shared include.
+#include "project.hpp"
+
 // Qt include.
-#include <QApplication>
+#include <QDateTime>
 #include <QMenu>
+#include <QStandardPaths>
 #include <QStatusBar>
 #include <QVBoxLayout>
 #include <QtConcurrent>
@@ -19,12 +24,18 @@
 namespace /* anonymous */
 {
 
-bool readGIFFunc(QGifLib::Gif *container,
+bool readGIFFunc(Frames *container,
                  const QString &fileName)
 {
     return container->load(fileName);
 }
 
+bool readSharedFunc(Frames *container,
+                    const QString &name)
+{
+    return container->loadShared(name);
+}
+
 } /* namespace anonymous */
 
 //
@@ -66,6 +77,9 @@ MainWindowPrivate::MainWindowPrivate(MainWindow *parent)
     l->addItem(new QSpacerItem(10, 0, QSizePolicy::Fixed, QSizePolicy::Expanding));
 
     QObject::connect(m_updateWatcher, &QFutureWatcher<Update>::finished, m_q, &MainWindow::onCheckForUpdatesFinished);
+
+    m_frames.cache().setBudget(Settings::instance().frameCacheSize());
+    m_view->tape()->setThumbnailCacheSize(Settings::instance().thumbnailCacheSize());
 }
 
 void MainWindowPrivate::clearView()
@@ -91,9 +105,7 @@ void MainWindowPrivate::initTape()
 {
     for (qsizetype i = 0, last = m_frames.count(); i < last; ++i) {
         m_view->tape()->addFrame({m_frames, i, false});
-
-        QApplication::processEvents();
-    };
+    }
 }
 
 void MainWindowPrivate::setSaveAction()
@@ -166,6 +178,7 @@ void MainWindowPrivate::openGif(const QString &fileName)
     setModified(false);
 
     m_currentGif = fileName;
+    m_sharedName.clear();
     m_busyStatusLabel->setText(MainWindow::tr("Loading GIF..."));
 
     m_q->connect(&m_readWatcher, &QFutureWatcher<bool>::finished, m_q, &MainWindow::gifLoaded);
@@ -173,25 +186,33 @@ void MainWindowPrivate::openGif(const QString &fileName)
     m_readWatcher.setFuture(future);
 }
 
-void MainWindowPrivate::calculateTimings()
+void MainWindowPrivate::openShared(const QString &name)
 {
-    m_timings.clear();
-    m_timings.push_back(0);
+    emit m_q->openFileTriggered();
+
+    clearView();
 
-    int ms = 0;
-    int total = 0;
+    setModified(false);
 
-    for (qsizetype i = 0; i < m_frames.count(); ++i) {
-        ms += m_frames.delay(i);
+    // Frames aren't saved anywhere yet, GIF is saved as a new file.
+    const auto dirs = QStandardPaths::standardLocations(QStandardPaths::PicturesLocation);
+    m_currentGif = QDir(!dirs.isEmpty() ? dirs.first() : QDir::homePath())
+                       .filePath(QStringLiteral("recording-%1.%2")
+                                     .arg(QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-hhmmss")),
+                                          projectSuffix()));
+    m_sharedName = name;
+    m_busyStatusLabel->setText(MainWindow::tr("Loading GIF..."));
 
-        if (i != m_frames.count() - 1) {
-            total = ms;
-        }
+    m_q->connect(&m_readWatcher, &QFutureWatcher<bool>::finished, m_q, &MainWindow::gifLoaded);
+    auto future = QtConcurrent::run(readSharedFunc, &m_frames, name);
+    m_readWatcher.setFuture(future);
+}
 
-        m_timings.push_back(ms);
-    }
+void MainWindowPrivate::calculateTimings()
+{
+    const auto total = (m_frames.count() ? m_frames.timestamp(m_frames.count() - 1) : 0);
 
-    m_totalDuration = QTime::fromMSecsSinceStartOfDay(total).toString(QStringLiteral("hh:mm:ss.zzz"));
+    m_totalDuration = QTime::fromMSecsSinceStartOfDay(static_cast<int>(total)).toString(QStringLiteral("hh:mm:ss.zzz"));
 }
 
 void MainWindowPrivate::setActionsToInitialState()
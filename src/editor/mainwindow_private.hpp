@@ -74,7 +74,9 @@ public:
     int nextCheckedFrame(int current) const;
     //! Open file.
     void openGif(const QString &fileName);
-    //! Calculate timings.
+    //! Open frames passed by the recorder through shared memory.
+    void openShared(const QString &name);
+    //! Calculate total duration.
     void calculateTimings();
     //! Set actions to initial state.
     void setActionsToInitialState();
@@ -90,9 +92,7 @@ public:
     //! Total duration of the GIF.
     QString m_totalDuration;
     //! Frames.
-    QGifLib::Gif m_frames;
-    //! Timings.
-    QVector<int> m_timings;
+    Frames m_frames;
     //! Edit mode.
     EditMode m_editMode;
     //! Busy flag.
@@ -103,6 +103,10 @@ public:
     bool m_shownAlready = false;
     //! File name to open after show event.
     QString m_fileNameToOpenAfterShow;
+    //! Shared memory segment to open after show event.
+    QString m_sharedToOpenAfterShow;
+    //! Shared memory segment being loaded, empty if a file is loaded.
+    QString m_sharedName;
     //! Future watcher.
     QFutureWatcher<void> m_watcher;
     //! Read GIF future watcher.
@@ -10,6 +10,7 @@
 #include <QCheckBox>
 #include <QDialogButtonBox>
 #include <QSettings>
+#include <QSpinBox>
 
 //
 // Settings
@@ -132,6 +133,30 @@ void Settings::setUpdatesUrl(const QString &u)
     saveCfg();
 }
 
+int Settings::frameCacheSize() const
+{
+    return m_frameCacheSize;
+}
+
+void Settings::setFrameCacheSize(int megabytes)
+{
+    m_frameCacheSize = megabytes;
+
+    saveCfg();
+}
+
+int Settings::thumbnailCacheSize() const
+{
+    return m_thumbnailCacheSize;
+}
+
+void Settings::setThumbnailCacheSize(int megabytes)
+{
+    m_thumbnailCacheSize = megabytes;
+
+    saveCfg();
+}
+
 void Settings::setAppWinMaximized(bool on)
 {
     m_isAppWinMaximized = on;
@@ -155,6 +180,9 @@ static const QString s_lastCheckForUpdates = QStringLiteral("lastCheckForUpdates
 static const QString s_updatesAvailable = QStringLiteral("updatesAvailable");
 static const QString s_updates = QStringLiteral("updates");
 static const QString s_updatesUrl = QStringLiteral("updatesUrl");
+static const QString s_memory = QStringLiteral("memory");
+static const QString s_frameCacheSize = QStringLiteral("frameCacheSize");
+static const QString s_thumbnailCacheSize = QStringLiteral("thumbnailCacheSize");
 
 void Settings::readCfg()
 {
@@ -192,6 +220,11 @@ void Settings::readCfg()
     m_updatesAvailable = s.value(s_updatesAvailable, QString()).toString();
     m_updatesUrl = s.value(s_updatesUrl, QString()).toString();
     s.endGroup();
+
+    s.beginGroup(s_memory);
+    m_frameCacheSize = s.value(s_frameCacheSize, FrameCache::s_defaultBudget).toInt();
+    m_thumbnailCacheSize = s.value(s_thumbnailCacheSize, ThumbnailCache::s_defaultSize).toInt();
+    s.endGroup();
 }
 
 void Settings::saveCfg()
@@ -227,6 +260,11 @@ void Settings::saveCfg()
     s.setValue(s_updatesAvailable, m_updatesAvailable);
     s.setValue(s_updatesUrl, m_updatesUrl);
     s.endGroup();
+
+    s.beginGroup(s_memory);
+    s.setValue(s_frameCacheSize, m_frameCacheSize);
+    s.setValue(s_thumbnailCacheSize, m_thumbnailCacheSize);
+    s.endGroup();
 }
 
 //
@@ -238,6 +276,8 @@ SettingsDlg::SettingsDlg(QWidget *parent)
     m_ui.setupUi(this);
 
     m_ui.m_showHelpMsg->setChecked(Settings::instance().showHelpMsg());
+    m_ui.m_frameCache->setValue(Settings::instance().frameCacheSize());
+    m_ui.m_thumbnailCache->setValue(Settings::instance().thumbnailCacheSize());
 
     connect(m_ui.m_buttonBox, &QDialogButtonBox::accepted, this, &SettingsDlg::onApply);
 }
@@ -249,4 +289,6 @@ SettingsDlg::~SettingsDlg()
 void SettingsDlg::onApply()
 {
     Settings::instance().setShowHelpMsg(m_ui.m_showHelpMsg->isChecked());
+    Settings::instance().setFrameCacheSize(m_ui.m_frameCache->value());
+    Settings::instance().setThumbnailCacheSize(m_ui.m_thumbnailCache->value());
 }
@@ -7,6 +7,8 @@
 #define GIF_EDITOR_SETTINGS_HPP_INCLUDED
 
 // GIF editor include.
+#include "frame_cache.hpp"
+#include "thumbnail_cache.hpp"
 #include "ui_settings.h"
 
 // Qt include.
@@ -62,6 +64,14 @@ public:
     const QString &updatesUrl() const;
     //! Set update release page URL.
     void setUpdatesUrl(const QString &u);
+    //! \return Memory for decoded frames, in megabytes.
+    int frameCacheSize() const;
+    //! Set memory for decoded frames, in megabytes.
+    void setFrameCacheSize(int megabytes);
+    //! \return Size of the cache of thumbnails on disk, in megabytes.
+    int thumbnailCacheSize() const;
+    //! Set size of the cache of thumbnails on disk, in megabytes.
+    void setThumbnailCacheSize(int megabytes);
 
 private:
     void readCfg();
@@ -86,6 +96,10 @@ private:
     QString m_updatesAvailable;
     //! URL to release page.
     QString m_updatesUrl;
+    //! Memory for decoded frames, in megabytes.
+    int m_frameCacheSize = FrameCache::s_defaultBudget;
+    //! Size of the cache of thumbnails on disk, in megabytes.
+    int m_thumbnailCacheSize = ThumbnailCache::s_defaultSize;
 }; // class Settings
 
 //
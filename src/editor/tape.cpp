@@ -6,15 +6,99 @@
 // GIF editor include.
 #include "tape.hpp"
 #include "frameontape.hpp"
+#include "thumbnail_service.hpp"
 
 // Qt include.
-#include <QApplication>
-#include <QHBoxLayout>
 #include <QList>
+#include <QMoveEvent>
+#include <QResizeEvent>
 
 // C++ include.
 #include <utility>
 
+//
+// TapeItem
+//
+
+TapeItem::TapeItem(Tape *tape,
+                   const ImageRef &img,
+                   int counter)
+    : m_tape(tape)
+    , m_image(img)
+    , m_counter(counter)
+{
+}
+
+const ImageRef &TapeItem::image() const
+{
+    return m_image;
+}
+
+bool TapeItem::isChecked() const
+{
+    return m_checked;
+}
+
+void TapeItem::setChecked(bool on)
+{
+    if (m_checked != on) {
+        m_checked = on;
+
+        if (m_widget) {
+            m_widget->setChecked(on);
+        }
+
+        emit m_tape->checkStateChanged(m_counter, on);
+    }
+}
+
+int TapeItem::counter() const
+{
+    return m_counter;
+}
+
+void TapeItem::setCounter(int c)
+{
+    m_counter = c;
+
+    if (m_widget) {
+        m_widget->setCounter(c);
+    }
+}
+
+bool TapeItem::isCurrent() const
+{
+    return m_current;
+}
+
+void TapeItem::setCurrent(bool on)
+{
+    m_current = on;
+
+    if (m_widget) {
+        m_widget->setCurrent(on);
+    }
+}
+
+bool TapeItem::isModified() const
+{
+    return m_modified;
+}
+
+void TapeItem::setModified(bool on)
+{
+    m_modified = on;
+
+    if (m_widget) {
+        m_widget->setModified(on);
+    }
+}
+
+int TapeItem::width() const
+{
+    return m_tape->itemWidth();
+}
+
 //
 // TapePrivate
 //
@@ -23,31 +107,290 @@ class TapePrivate
 {
 public:
     TapePrivate(Tape *parent)
-        : m_currentFrame(nullptr)
-        , m_layout(new QHBoxLayout(parent))
-        , m_q(parent)
+        : m_q(parent)
     {
-        m_layout->setContentsMargins(m_q->spacing(), m_q->spacing(), m_q->spacing(), m_q->spacing());
-        m_layout->setSpacing(m_q->spacing());
     }
 
-    void clearImages()
+    //! \return Height of frames.
+    int itemHeight() const
     {
-        for (auto &f : std::as_const(m_frames)) {
-            f->clearImage();
-        }
+        return m_q->height() - m_q->spacing() * 2;
     }
 
+    //! \return Range of visible frames, from 0, with \a margin frames around.
+    std::pair<int, int> visibleRange(int margin = s_margin) const;
+    //! Create widget.
+    FrameOnTape *createWidget(TapeItem *item);
+    //! Show the item with free or new widget.
+    void bind(TapeItem *item);
+    //! Return widget of the item to free widgets.
+    void unbind(TapeItem *item);
+    //! Remove all widgets.
+    void removeWidgets();
+    //! Bind visible frames with widgets and place them.
+    void layoutFrames();
+    //! Remove frame, widgets aren't placed.
+    void removeFrame(int idx);
+    //! Request thumbnails of frames in the \a range, their neighbours and frames around.
+    void requestThumbnails(const std::pair<int, int> &range);
+    //! Thumbnail is ready.
+    void thumbnailReady(qsizetype idx,
+                        const QImage &thumbnail);
+
+    //! Count of frames around visible ones that have widgets.
+    static constexpr int s_margin = 5;
+    //! Count of frames around ones with widgets which thumbnails are made ahead.
+    static constexpr int s_prefetch = 20;
+
     //! Frames.
-    QList<FrameOnTape *> m_frames;
+    QList<TapeItem *> m_frames;
     //! Current frame.
-    FrameOnTape *m_currentFrame;
-    //! Layout.
-    QHBoxLayout *m_layout;
+    TapeItem *m_currentFrame = nullptr;
+    //! Widgets not bound to frames.
+    QList<FrameOnTape *> m_freeWidgets;
+    //! Frames with widgets.
+    QList<TapeItem *> m_bound;
+    //! Width of frames, known when the first widget is created.
+    int m_itemWidth = 0;
+    //! Height of frames of created widgets.
+    int m_itemHeight = 0;
+    //! Height of thumbnails of created widgets.
+    int m_thumbnailHeight = 0;
+    //! Thumbnails.
+    ThumbnailService m_thumbnails;
     //! Parent.
     Tape *m_q;
 }; // class TapePrivate
 
+std::pair<int, int> TapePrivate::visibleRange(int margin) const
+{
+    if (m_frames.isEmpty()) {
+        return {0, -1};
+    }
+
+    if (!m_itemWidth) {
+        return {0, 0};
+    }
+
+    // Tape is moved inside of the viewport of the scroll area.
+    const auto left = (m_q->parentWidget() ? -m_q->x() : 0);
+    const auto right = left + (m_q->parentWidget() ? m_q->parentWidget()->width() : m_q->width());
+    const auto step = m_itemWidth + m_q->spacing();
+
+    const auto first = qMax(0, (left - m_q->spacing()) / step - margin);
+    const auto last = qMin(static_cast<int>(m_frames.size()) - 1, (right - m_q->spacing()) / step + margin);
+
+    return {first, last};
+}
+
+FrameOnTape *TapePrivate::createWidget(TapeItem *item)
+{
+    auto w = new FrameOnTape(item->image(), item->counter(), itemHeight(), m_q);
+
+    Tape::connect(w, &FrameOnTape::checkTillEnd, m_q, &Tape::checkTillEnd);
+
+    Tape::connect(w, &FrameOnTape::clicked, m_q, [this](int idx) {
+        if (this->m_currentFrame) {
+            this->m_currentFrame->setCurrent(false);
+        }
+
+        this->m_currentFrame = this->m_q->frame(idx);
+
+        this->m_currentFrame->setCurrent(true);
+
+        emit this->m_q->currentFrameChanged(idx);
+
+        emit this->m_q->clicked(idx);
+    });
+
+    Tape::connect(w, &FrameOnTape::checked, m_q, [this](int idx, bool on) {
+        if (auto item = this->m_q->frame(idx)) {
+            item->setChecked(on);
+        }
+    });
+
+    Tape::connect(w, &FrameOnTape::changed, m_q, &Tape::frameChanged);
+
+    return w;
+}
+
+void TapePrivate::bind(TapeItem *item)
+{
+    FrameOnTape *w = nullptr;
+
+    if (!m_freeWidgets.isEmpty()) {
+        w = m_freeWidgets.takeLast();
+    } else {
+        w = createWidget(item);
+        m_itemHeight = itemHeight();
+
+        if (!m_thumbnailHeight) {
+            m_thumbnailHeight = w->thumbnailHeight();
+        }
+    }
+
+    item->m_widget = w;
+    w->setItem(item);
+    m_bound.append(item);
+
+    if (!m_itemWidth) {
+        m_itemWidth = w->sizeHint().width();
+
+        // Size of the tape is known now, it's changed out of placing of widgets.
+        QMetaObject::invokeMethod(m_q, &QWidget::adjustSize, Qt::QueuedConnection);
+    }
+}
+
+void TapePrivate::unbind(TapeItem *item)
+{
+    if (item->m_widget) {
+        item->m_widget->hide();
+        item->m_widget->setItem(nullptr);
+        m_freeWidgets.append(item->m_widget);
+        item->m_widget = nullptr;
+    }
+}
+
+void TapePrivate::removeWidgets()
+{
+    for (const auto &item : std::as_const(m_bound)) {
+        unbind(item);
+    }
+
+    m_bound.clear();
+
+    for (const auto &w : std::as_const(m_freeWidgets)) {
+        w->deleteLater();
+    }
+
+    m_freeWidgets.clear();
+    m_itemWidth = 0;
+    m_itemHeight = 0;
+    m_thumbnailHeight = 0;
+}
+
+void TapePrivate::layoutFrames()
+{
+    // Thumbnails are made for the height of the tape.
+    if (m_itemHeight && m_itemHeight != itemHeight()) {
+        removeWidgets();
+    }
+
+    auto range = visibleRange();
+
+    for (qsizetype i = 0; i < m_bound.size();) {
+        const auto idx = m_bound.at(i)->m_counter - 1;
+
+        if (idx < range.first || idx > range.second) {
+            unbind(m_bound.at(i));
+            m_bound.removeAt(i);
+        } else {
+            ++i;
+        }
+    }
+
+    // Width of frames is known only with the first widget.
+    if (!m_itemWidth && !m_frames.isEmpty()) {
+        bind(m_frames.front());
+
+        range = visibleRange();
+    }
+
+    for (int i = range.first; i <= range.second; ++i) {
+        auto item = m_frames.at(i);
+
+        if (!item->m_widget) {
+            bind(item);
+        }
+
+        item->m_widget->setGeometry(m_q->xOfFrame(i + 1), m_q->spacing(), m_itemWidth, itemHeight());
+        item->m_widget->show();
+    }
+
+    requestThumbnails(range);
+}
+
+void TapePrivate::requestThumbnails(const std::pair<int, int> &range)
+{
+    // Frames scrolled out of view don't need thumbnails anymore.
+    m_thumbnails.cancel();
+
+    if (range.first > range.second || !m_thumbnailHeight) {
+        return;
+    }
+
+    const auto visible = visibleRange(0);
+
+    for (int i = range.first; i <= range.second; ++i) {
+        const auto item = m_frames.at(i);
+
+        if (item->m_widget->hasThumbnail()) {
+            continue;
+        }
+
+        const auto thumbnail = m_thumbnails.thumbnail(item->m_image.m_pos, m_thumbnailHeight);
+
+        if (!thumbnail.isNull()) {
+            item->m_widget->setThumbnail(thumbnail);
+        } else {
+            m_thumbnails.request(item->m_image,
+                                 m_thumbnailHeight,
+                                 (i >= visible.first && i <= visible.second ? ThumbnailService::Visible
+                                                                            : ThumbnailService::Neighbour));
+        }
+    }
+
+    const auto first = qMax(0, range.first - s_prefetch);
+    const auto last = qMin(static_cast<int>(m_frames.size()) - 1, range.second + s_prefetch);
+
+    for (int i = first; i <= last; ++i) {
+        if (i < range.first || i > range.second) {
+            m_thumbnails.request(m_frames.at(i)->m_image, m_thumbnailHeight, ThumbnailService::Prefetch);
+        }
+    }
+}
+
+void TapePrivate::thumbnailReady(qsizetype idx,
+                                 const QImage &thumbnail)
+{
+    for (const auto &item : std::as_const(m_bound)) {
+        if (item->m_image.m_pos == idx) {
+            item->m_widget->setThumbnail(thumbnail);
+        }
+    }
+}
+
+void TapePrivate::removeFrame(int idx)
+{
+    auto item = m_frames.at(idx - 1);
+
+    if (item == m_currentFrame) {
+        m_currentFrame = nullptr;
+
+        if (idx > 1) {
+            m_currentFrame = m_frames.at(idx - 2);
+            m_currentFrame->setCurrent(true);
+
+            emit m_q->currentFrameChanged(idx - 1);
+        } else if (idx < m_frames.size()) {
+            m_currentFrame = m_frames.at(idx);
+            m_currentFrame->setCurrent(true);
+
+            emit m_q->currentFrameChanged(idx + 1);
+        } else {
+            m_currentFrame = nullptr;
+
+            emit m_q->currentFrameChanged(0);
+        }
+    }
+
+    m_bound.removeOne(item);
+    unbind(item);
+    m_frames.removeAt(idx - 1);
+
+    delete item;
+}
+
 //
 // Tape
 //
@@ -56,10 +399,14 @@ Tape::Tape(QWidget *parent)
     : QWidget(parent)
     , m_d(new TapePrivate(this))
 {
+    connect(&m_d->m_thumbnails, &ThumbnailService::ready, this, [this](qsizetype idx, const QImage &thumbnail) {
+        this->m_d->thumbnailReady(idx, thumbnail);
+    });
 }
 
 Tape::~Tape() noexcept
 {
+    qDeleteAll(m_d->m_frames);
 }
 
 int Tape::count() const
@@ -69,36 +416,19 @@ int Tape::count() const
 
 void Tape::addFrame(const ImageRef &img)
 {
-    m_d->m_frames.append(
-        new FrameOnTape(img,
-                        count() + 1,
-                        height() - m_d->m_layout->contentsMargins().bottom() - m_d->m_layout->contentsMargins().top(),
-                        this));
-    connect(m_d->m_frames.back(), &FrameOnTape::checkTillEnd, this, &Tape::checkTillEnd);
-    m_d->m_layout->addWidget(m_d->m_frames.back());
-
-    QApplication::processEvents();
-
-    connect(m_d->m_frames.back(), &FrameOnTape::clicked, this, [this](int idx) {
-        if (this->currentFrame())
-            this->currentFrame()->setCurrent(false);
-
-        this->m_d->m_currentFrame = this->frame(idx);
-
-        this->m_d->m_currentFrame->setCurrent(true);
+    m_d->m_frames.append(new TapeItem(this, img, count() + 1));
 
-        emit this->currentFrameChanged(idx);
+    const auto range = m_d->visibleRange();
 
-        emit this->clicked(idx);
-    });
-
-    connect(m_d->m_frames.back(), &FrameOnTape::checked, this, &Tape::checkStateChanged);
-    connect(m_d->m_frames.back(), &FrameOnTape::changed, this, &Tape::frameChanged);
+    // Only frames near visible ones have widgets or thumbnails made ahead.
+    if (count() - 1 <= range.second + TapePrivate::s_prefetch) {
+        m_d->layoutFrames();
+    }
 
     adjustSize();
 }
 
-FrameOnTape *Tape::frame(int idx) const
+TapeItem *Tape::frame(int idx) const
 {
     if (idx >= 1 && idx <= count()) {
         return m_d->m_frames.at(idx - 1);
@@ -107,7 +437,7 @@ FrameOnTape *Tape::frame(int idx) const
     }
 }
 
-FrameOnTape *Tape::currentFrame() const
+TapeItem *Tape::currentFrame() const
 {
     return m_d->m_currentFrame;
 }
@@ -130,31 +460,14 @@ void Tape::setCurrentFrame(int idx)
 
 void Tape::removeFrame(int idx)
 {
-    if (idx <= count()) {
-        m_d->m_layout->removeWidget(m_d->m_frames.at(idx - 1));
-        m_d->m_frames.at(idx - 1)->deleteLater();
-
-        if (m_d->m_frames.at(idx - 1) == m_d->m_currentFrame) {
-            m_d->m_currentFrame = nullptr;
-
-            if (idx > 1) {
-                m_d->m_currentFrame = m_d->m_frames.at(idx - 2);
-                m_d->m_currentFrame->setCurrent(true);
-
-                emit currentFrameChanged(idx - 1);
-            } else if (idx < count()) {
-                m_d->m_currentFrame = m_d->m_frames.at(idx);
-                m_d->m_currentFrame->setCurrent(true);
-
-                emit currentFrameChanged(idx + 1);
-            } else {
-                m_d->m_currentFrame = nullptr;
+    if (idx >= 1 && idx <= count()) {
+        m_d->removeFrame(idx);
 
-                emit currentFrameChanged(0);
-            }
+        for (int i = idx; i <= count(); ++i) {
+            frame(i)->setCounter(i);
         }
 
-        m_d->m_frames.removeAt(idx - 1);
+        m_d->layoutFrames();
 
         adjustSize();
     }
@@ -162,19 +475,17 @@ void Tape::removeFrame(int idx)
 
 void Tape::clear()
 {
-    const int c = count();
-
-    for (int i = 0; i < c; ++i) {
-        m_d->m_layout->removeWidget(m_d->m_frames.at(i));
-        m_d->m_frames.at(i)->deleteLater();
-        QApplication::processEvents();
-    }
+    m_d->m_thumbnails.clear();
+    m_d->removeWidgets();
 
+    qDeleteAll(m_d->m_frames);
     m_d->m_frames.clear();
 
     m_d->m_currentFrame = nullptr;
 
     emit currentFrameChanged(0);
+
+    adjustSize();
 }
 
 void Tape::removeUnchecked()
@@ -184,15 +495,17 @@ void Tape::removeUnchecked()
 
     for (int i = 1; i <= c; ++i) {
         if (!frame(i - removed)->isChecked()) {
-            removeFrame(i - removed);
+            m_d->removeFrame(i - removed);
 
             ++removed;
-
-            QApplication::processEvents();
         } else {
             frame(i - removed)->setCounter(i - removed);
         }
     }
+
+    m_d->layoutFrames();
+
+    adjustSize();
 }
 
 void Tape::checkTillEnd(int idx,
@@ -206,9 +519,7 @@ void Tape::checkTillEnd(int idx,
 int Tape::xOfFrame(int idx) const
 {
     if (idx >= 1 && idx <= count()) {
-        return m_d->m_layout->contentsMargins().left()
-            + (idx - 1) * m_d->m_currentFrame->width()
-            + (idx - 1) * m_d->m_layout->spacing();
+        return spacing() + (idx - 1) * (m_d->m_itemWidth + spacing());
     } else {
         return -1;
     }
@@ -218,3 +529,48 @@ int Tape::spacing() const
 {
     return 5;
 }
+
+void Tape::setThumbnailCacheSize(int megabytes)
+{
+    m_d->m_thumbnails.diskCache().setSize(megabytes);
+}
+
+void Tape::setThumbnailsEnabled(bool on)
+{
+    m_d->m_thumbnails.setEnabled(on);
+
+    if (on) {
+        m_d->layoutFrames();
+    }
+}
+
+int Tape::itemWidth() const
+{
+    return m_d->m_itemWidth;
+}
+
+QSize Tape::sizeHint() const
+{
+    return minimumSizeHint();
+}
+
+QSize Tape::minimumSizeHint() const
+{
+    const auto c = count();
+
+    return {(c ? spacing() + c * (m_d->m_itemWidth + spacing()) : 0), minimumHeight()};
+}
+
+void Tape::moveEvent(QMoveEvent *e)
+{
+    m_d->layoutFrames();
+
+    e->accept();
+}
+
+void Tape::resizeEvent(QResizeEvent *e)
+{
+    m_d->layoutFrames();
+
+    e->accept();
+}
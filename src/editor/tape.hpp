@@ -14,6 +14,68 @@
 #include "frame.hpp"
 
 class FrameOnTape;
+class Tape;
+
+//
+// TapeItem
+//
+
+//! Frame on the tape. Items exist for all frames, widgets show only visible ones.
+class TapeItem final
+{
+public:
+    TapeItem(Tape *tape,
+             const ImageRef &img,
+             int counter);
+    ~TapeItem() = default;
+
+    //! \return Image.
+    const ImageRef &image() const;
+
+    //! \return Is frame checked.
+    bool isChecked() const;
+    //! Set checked.
+    void setChecked(bool on = true);
+
+    //! \return Counter.
+    int counter() const;
+    //! Set counter.
+    void setCounter(int c);
+
+    //! \return Is this frame current?
+    bool isCurrent() const;
+    //! Set current flag.
+    void setCurrent(bool on = true);
+
+    //! \return Is frame modified.
+    bool isModified() const;
+    //! Set modified flag.
+    void setModified(bool on = true);
+
+    //! \return Width of the frame on the tape.
+    int width() const;
+
+private:
+    friend class Tape;
+    friend class TapePrivate;
+
+    Q_DISABLE_COPY(TapeItem)
+
+    //! Tape.
+    Tape *m_tape;
+    //! Image reference.
+    ImageRef m_image;
+    //! Counter.
+    int m_counter;
+    //! Is checked?
+    bool m_checked = true;
+    //! Is current?
+    bool m_current = false;
+    //! Is modified?
+    bool m_modified = false;
+    //! Widget that shows this frame, null if the frame isn't visible.
+    FrameOnTape *m_widget = nullptr;
+}; // class TapeItem
 
 //
 // Tape
@@ -21,7 +83,8 @@ class FrameOnTape;
 
 class TapePrivate;
 
-//! Tape with frames.
+//! Tape with frames. Widgets are created only for visible frames and a few frames around them,
+//! they are reused for other frames when the tape is scrolled.
 class Tape final : public QWidget
 {
     Q_OBJECT
@@ -46,9 +109,9 @@ public:
     //! Add frame.
     void addFrame(const ImageRef &img);
     //! \return Frame.
-    FrameOnTape *frame(int idx) const;
+    TapeItem *frame(int idx) const;
     //! \return Current frame.
-    FrameOnTape *currentFrame() const;
+    TapeItem *currentFrame() const;
     //! Set current frame.
     void setCurrentFrame(int idx);
     //! Clear.
@@ -61,6 +124,18 @@ public:
     int xOfFrame(int idx) const;
     //! \return Layout spacing.
     int spacing() const;
+    //! Set size of the cache of thumbnails on disk, in megabytes.
+    void setThumbnailCacheSize(int megabytes);
+    //! Make thumbnails or not. When turned off, making of thumbnails is stopped
+    //! and waited for, so frames may be changed.
+    void setThumbnailsEnabled(bool on);
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+protected:
+    void moveEvent(QMoveEvent *e) override;
+    void resizeEvent(QResizeEvent *e) override;
 
 private slots:
     //! Check/uncheck till end action activated.
@@ -68,6 +143,11 @@ private slots:
                       bool on);
 
 private:
+    friend class TapeItem;
+
+    //! \return Width of frames.
+    int itemWidth() const;
+
     Q_DISABLE_COPY(Tape)
 
     QScopedPointer<TapePrivate> m_d;
@@ -0,0 +1,154 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF editor include.
+#include "thumbnail_cache.hpp"
+
+// Qt include.
+#include <QBuffer>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+//
+// ThumbnailCache
+//
+
+ThumbnailCache::ThumbnailCache(const QString &path,
+                               int size)
+    : m_path(path)
+    , m_maxSize(static_cast<qint64>(size) * 1024 * 1024)
+{
+}
+
+int ThumbnailCache::size() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return static_cast<int>(m_maxSize / 1024 / 1024);
+}
+
+void ThumbnailCache::setSize(int megabytes)
+{
+    QMutexLocker lock(&m_mutex);
+
+    m_maxSize = static_cast<qint64>(megabytes) * 1024 * 1024;
+
+    if (m_usedSize > m_maxSize) {
+        trim();
+    }
+}
+
+QImage ThumbnailCache::find(size_t hash,
+                            int height) const
+{
+    {
+        QMutexLocker lock(&m_mutex);
+
+        if (!m_maxSize) {
+            return {};
+        }
+    }
+
+    QFile file(fileName(hash, height));
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+
+    // Time of modification is the time of the last use.
+    file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+
+    QImage img;
+    img.load(&file, "PNG");
+
+    return img;
+}
+
+void ThumbnailCache::insert(size_t hash,
+                            const QImage &thumbnail)
+{
+    bool scan = false;
+
+    {
+        QMutexLocker lock(&m_mutex);
+
+        if (!m_maxSize || thumbnail.isNull()) {
+            return;
+        }
+
+        scan = (m_usedSize < 0);
+    }
+
+    // Thumbnails are encoded and written in parallel, only the accounting is locked.
+    QByteArray data;
+    QBuffer buffer(&data);
+
+    if (!buffer.open(QIODevice::WriteOnly) || !thumbnail.save(&buffer, "PNG") || !QDir().mkpath(m_path)) {
+        return;
+    }
+
+    // Thumbnail appears at once, so it's never read half-written.
+    QSaveFile file(fileName(hash, thumbnail.height()));
+
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        return;
+    }
+
+    qint64 usedSize = 0;
+
+    if (scan) {
+        const auto files = QDir(m_path).entryInfoList({QStringLiteral("*.png")}, QDir::Files);
+
+        for (const auto &f : files) {
+            usedSize += f.size();
+        }
+    }
+
+    QMutexLocker lock(&m_mutex);
+
+    if (m_usedSize < 0) {
+        m_usedSize = (scan ? usedSize : data.size());
+    } else {
+        m_usedSize += data.size();
+    }
+
+    if (m_usedSize > m_maxSize) {
+        trim();
+    }
+}
+
+QString ThumbnailCache::fileName(size_t hash,
+                                 int height) const
+{
+    return QDir(m_path).filePath(
+        QStringLiteral("%1-%2.png").arg(static_cast<quint64>(hash), 16, 16, QLatin1Char('0')).arg(height));
+}
+
+void ThumbnailCache::trim()
+{
+    // Oldest first. Some room is freed at once, so the directory isn't read on every insert.
+    const auto files = QDir(m_path).entryInfoList({QStringLiteral("*.png")}, QDir::Files, QDir::Time | QDir::Reversed);
+    const auto target = m_maxSize / 10 * 8;
+
+    m_usedSize = 0;
+
+    for (const auto &f : files) {
+        m_usedSize += f.size();
+    }
+
+    for (const auto &f : files) {
+        if (m_usedSize <= target) {
+            break;
+        }
+
+        if (QFile::remove(f.absoluteFilePath())) {
+            m_usedSize -= f.size();
+        }
+    }
+}
@@ -0,0 +1,60 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QImage>
+#include <QMutex>
+#include <QString>
+
+//
+// ThumbnailCache
+//
+
+//! Cache of thumbnails on disk, thumbnails are found by hash of the frame and height, so
+//! they survive reopening of the file. When the size limit is exceeded the least recently
+//! used thumbnails are removed. Thread-safe.
+class ThumbnailCache final
+{
+public:
+    //! Default size limit, in megabytes.
+    static constexpr int s_defaultSize = 100;
+
+    //! Thumbnails are stored in the \a path directory, \a size is in megabytes.
+    explicit ThumbnailCache(const QString &path,
+                            int size = s_defaultSize);
+    ~ThumbnailCache() = default;
+
+    //! \return Size limit, in megabytes.
+    int size() const;
+    //! Set size limit in megabytes, 0 turns the cache off.
+    void setSize(int megabytes);
+
+    //! \return Thumbnail of the frame with the given hash and height, null if it isn't cached.
+    QImage find(size_t hash,
+                int height) const;
+    //! Store thumbnail of the frame with the given hash.
+    void insert(size_t hash,
+                const QImage &thumbnail);
+
+private:
+    Q_DISABLE_COPY(ThumbnailCache)
+
+    //! \return File of the thumbnail.
+    QString fileName(size_t hash,
+                     int height) const;
+    //! Remove the least recently used thumbnails to fit the limit. Called under the lock.
+    void trim();
+
+    //! Directory.
+    QString m_path;
+    //! Guard.
+    mutable QMutex m_mutex;
+    //! Size limit, in bytes.
+    qint64 m_maxSize;
+    //! Size of stored thumbnails, in bytes, -1 if the directory isn't read yet.
+    qint64 m_usedSize = -1;
+}; // class ThumbnailCache
@@ -0,0 +1,201 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF editor include.
+#include "thumbnail_service.hpp"
+#include "frame.hpp"
+
+// Qt include.
+#include <QDir>
+#include <QStandardPaths>
+#include <QThread>
+#include <QtConcurrent>
+
+namespace /* anonymous */
+{
+
+//! Memory for ready thumbnails, in kilobytes.
+const qsizetype s_cacheSize = 32 * 1024;
+
+//! \return Thumbnail of the frame.
+QImage makeThumbnail(const Frames &frames,
+                     ThumbnailCache &cache,
+                     qsizetype idx,
+                     int height)
+{
+    const auto hash = frames.hash(idx);
+    const auto size = frames.size(idx);
+    // Small frames aren't scaled.
+    const auto thumbnailHeight = (size.height() > height ? height : size.height());
+
+    // Found without decoding of the frame.
+    auto thumbnail = cache.find(hash, thumbnailHeight);
+
+    if (!thumbnail.isNull()) {
+        return thumbnail;
+    }
+
+    const auto img = frames.at(idx);
+
+    thumbnail = (img.height() > height ? img.scaledToHeight(height, Qt::SmoothTransformation) : img);
+
+    // Frame changed after its hash was taken, thumbnail doesn't belong to that hash.
+    if (frames.hash(idx) == hash) {
+        cache.insert(hash, thumbnail);
+    }
+
+    return thumbnail;
+}
+
+} /* namespace anonymous */
+
+//
+// ThumbnailService
+//
+
+ThumbnailService::ThumbnailService(QObject *parent)
+    : QObject(parent)
+    , m_thumbnails(s_cacheSize)
+    , m_diskCache(QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation))
+                      .filePath(QStringLiteral("thumbnails")))
+{
+    // GUI thread and decoding of frames for the view should have cores too.
+    m_pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount() - 1, 4));
+}
+
+ThumbnailService::~ThumbnailService()
+{
+    clear();
+}
+
+QImage ThumbnailService::thumbnail(qsizetype idx,
+                                   int height) const
+{
+    if (height != m_height) {
+        return {};
+    }
+
+    const auto img = m_thumbnails.object(idx);
+
+    return (img ? *img : QImage());
+}
+
+void ThumbnailService::request(const ImageRef &img,
+                               int height,
+                               Priority priority)
+{
+    if (!m_enabled || height <= 0) {
+        return;
+    }
+
+    // Thumbnails of other height aren't needed anymore.
+    if (height != m_height) {
+        cancel();
+        m_thumbnails.clear();
+        m_height = height;
+    }
+
+    m_frames = &img.m_gif;
+
+    if (m_thumbnails.contains(img.m_pos) || m_running.contains(img.m_pos)) {
+        return;
+    }
+
+    const auto it = m_pending.constFind(img.m_pos);
+
+    if (it != m_pending.cend()) {
+        if (it.value() <= priority) {
+            return;
+        }
+
+        m_queue.erase({it.value(), img.m_pos});
+    }
+
+    m_pending.insert(img.m_pos, priority);
+    m_queue.insert({priority, img.m_pos});
+
+    schedule();
+}
+
+void ThumbnailService::cancel()
+{
+    m_queue.clear();
+    m_pending.clear();
+}
+
+void ThumbnailService::clear()
+{
+    cancel();
+
+    ++m_generation;
+
+    m_pool.waitForDone();
+
+    m_running.clear();
+    m_thumbnails.clear();
+    m_frames = nullptr;
+    m_height = 0;
+}
+
+bool ThumbnailService::isEnabled() const
+{
+    return m_enabled;
+}
+
+void ThumbnailService::setEnabled(bool on)
+{
+    m_enabled = on;
+
+    if (!m_enabled) {
+        clear();
+    }
+}
+
+ThumbnailCache &ThumbnailService::diskCache()
+{
+    return m_diskCache;
+}
+
+void ThumbnailService::schedule()
+{
+    while (!m_queue.empty() && m_running.size() < m_pool.maxThreadCount()) {
+        const auto idx = m_queue.begin()->second;
+        const auto height = m_height;
+        const auto generation = m_generation;
+        const Frames *frames = m_frames;
+
+        m_queue.erase(m_queue.begin());
+        m_pending.remove(idx);
+        m_running.insert(idx);
+
+        QtConcurrent::run(&m_pool,
+                          [frames, cache = &m_diskCache, idx, height]() {
+                              return makeThumbnail(*frames, *cache, idx, height);
+                          })
+            .then(this, [this, idx, height, generation](const QImage &thumbnail) {
+                this->done(idx, height, generation, thumbnail);
+            });
+    }
+}
+
+void ThumbnailService::done(qsizetype idx,
+                            int height,
+                            quint64 generation,
+                            const QImage &thumbnail)
+{
+    if (generation != m_generation) {
+        return;
+    }
+
+    m_running.remove(idx);
+
+    if (height == m_height && !thumbnail.isNull()) {
+        m_thumbnails.insert(idx, new QImage(thumbnail), qMax<qsizetype>(1, thumbnail.sizeInBytes() / 1024));
+
+        emit ready(idx, thumbnail);
+    }
+
+    schedule();
+}
@@ -0,0 +1,107 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// GIF editor include.
+#include "thumbnail_cache.hpp"
+
+// Qt include.
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QSet>
+#include <QThreadPool>
+
+// C++ include.
+#include <set>
+#include <utility>
+
+class Frames;
+struct ImageRef;
+
+//
+// ThumbnailService
+//
+
+//! Maker of thumbnails of frames for the tape. Requests are served by priority in the pool
+//! with a few threads, pending requests may be cancelled. Ready thumbnails are cached in
+//! memory and on disk.
+class ThumbnailService final : public QObject
+{
+    Q_OBJECT
+
+signals:
+    //! Thumbnail of frame at the given index is ready.
+    void ready(qsizetype idx,
+               const QImage &thumbnail);
+
+public:
+    //! Priority of the request.
+    enum Priority {
+        //! Frame is visible.
+        Visible = 0,
+        //! Frame is near visible ones.
+        Neighbour,
+        //! Frame may become visible soon.
+        Prefetch
+    }; // enum Priority
+
+    explicit ThumbnailService(QObject *parent = nullptr);
+    ~ThumbnailService() override;
+
+    //! \return Ready thumbnail of frame at the given index for the given height, null if it isn't ready.
+    QImage thumbnail(qsizetype idx,
+                     int height) const;
+    //! Request thumbnail of the frame for the given height. Priority of pending request is updated.
+    void request(const ImageRef &img,
+                 int height,
+                 Priority priority);
+    //! Cancel pending requests, running ones are finished.
+    void cancel();
+    //! Cancel all requests and drop thumbnails. Waits for running requests.
+    void clear();
+    //! \return Are requests served.
+    bool isEnabled() const;
+    //! Serve requests or not. Disabled service is cleared and ignores requests, so frames
+    //! may be changed safely.
+    void setEnabled(bool on);
+
+    //! \return Cache of thumbnails on disk.
+    ThumbnailCache &diskCache();
+
+private:
+    Q_DISABLE_COPY(ThumbnailService)
+
+    //! Start pending requests while there are free threads.
+    void schedule();
+    //! Request is done.
+    void done(qsizetype idx,
+              int height,
+              quint64 generation,
+              const QImage &thumbnail);
+
+    //! Frames.
+    Frames *m_frames = nullptr;
+    //! Pool.
+    QThreadPool m_pool;
+    //! Pending requests ordered by priority.
+    std::set<std::pair<int, qsizetype>> m_queue;
+    //! Priorities of pending requests.
+    QHash<qsizetype, int> m_pending;
+    //! Running requests.
+    QSet<qsizetype> m_running;
+    //! Height of thumbnails.
+    int m_height = 0;
+    //! Generation of requests, results of cleared requests are dropped.
+    quint64 m_generation = 0;
+    //! Are requests served.
+    bool m_enabled = true;
+    //! Ready thumbnails, cost is in kilobytes.
+    QCache<qsizetype, QImage> m_thumbnails;
+    //! Thumbnails on disk.
+    ThumbnailCache m_diskCache;
+}; // class ThumbnailService
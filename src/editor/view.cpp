@@ -52,7 +52,7 @@ public:
 class ViewPrivate
 {
 public:
-    ViewPrivate(QGifLib::Gif &data,
+    ViewPrivate(Frames &data,
                 View *parent)
         : m_tape(nullptr)
         , m_currentFrame(new Frame({data,
@@ -91,7 +91,7 @@ public:
 // View
 //
 
-View::View(QGifLib::Gif &data,
+View::View(Frames &data,
            QWidget *parent)
     : QWidget(parent)
     , m_d(new ViewPrivate(data,
@@ -12,9 +12,7 @@
 
 // gif-editor include.
 #include "frame.hpp"
-
-// qgiflib include.
-#include <qgiflib.hpp>
+#include "frames.hpp"
 
 class Tape;
 class TextFrame;
@@ -40,7 +38,7 @@ signals:
     void doRepaint();
 
 public:
-    explicit View(QGifLib::Gif &data,
+    explicit View(Frames &data,
                   QWidget *parent = nullptr);
     ~View() noexcept override;
 
@@ -0,0 +1,254 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Qt include.
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QScreen>
+#include <QTextStream>
+#include <QThread>
+
+// GIF recorder include.
+#include "capture.hpp"
+
+// C++ include.
+#include <cmath>
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
+namespace /* anonymous */
+{
+
+//
+// SyntheticSource
+//
+
+//! Deterministic animated pattern. Every frame differs from the previous one in all pixels,
+//! it's the worst case for deduplication, quantization and compression.
+class SyntheticSource final : public CaptureBackend
+{
+public:
+    SyntheticSource() = default;
+
+    bool grab(const QRect &,
+              QImage &img,
+              const QRect &part) override
+    {
+        const auto n = m_frame++;
+
+        for (int y = part.top(); y <= part.bottom(); ++y) {
+            auto line = reinterpret_cast<QRgb *>(img.scanLine(y));
+
+            for (int x = part.left(); x <= part.right(); ++x) {
+                line[x] = qRgb((x + n * 3) & 0xFF, (y + n * 2) & 0xFF, ((x ^ y) + n) & 0xFF);
+            }
+        }
+
+        return true;
+    }
+
+private:
+    //! Number of the frame.
+    int m_frame = 0;
+}; // class SyntheticSource
+
+//! \return Peak resident set size in bytes, -1 if unknown.
+qint64 peakRss()
+{
+#ifdef Q_OS_UNIX
+    rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef Q_OS_MACOS
+        return usage.ru_maxrss;
+#else
+        return static_cast<qint64>(usage.ru_maxrss) * 1024;
+#endif
+    }
+#endif
+
+    return -1;
+}
+
+//! \return Is source of frames a real screen.
+bool isGrab(int argc,
+            char **argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--source=grab") == 0
+            || (std::strcmp(argv[i], "--source") == 0 && i + 1 < argc && std::strcmp(argv[i + 1], "grab") == 0)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} /* namespace anonymous */
+
+int main(int argc,
+         char **argv)
+{
+    // Synthetic pattern doesn't need a display.
+    if (!isGrab(argc, argv) && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QGuiApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("gif-recorder-bench"));
+
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Benchmark of capture and encoding of GIF recorder."));
+    parser.addHelpOption();
+
+    const QCommandLineOption sourceOption(QStringLiteral("source"),
+                                          QStringLiteral("Source of frames: synthetic or grab (e.g. under Xvfb)."),
+                                          QStringLiteral("source"),
+                                          QStringLiteral("synthetic"));
+    const QCommandLineOption secondsOption(QStringLiteral("seconds"),
+                                           QStringLiteral("Duration of capture, in seconds."),
+                                           QStringLiteral("N"),
+                                           QStringLiteral("10"));
+    const QCommandLineOption fpsOption(QStringLiteral("fps"),
+                                       QStringLiteral("Frames per second."),
+                                       QStringLiteral("N"),
+                                       QStringLiteral("24"));
+    const QCommandLineOption sizeOption(QStringLiteral("size"),
+                                        QStringLiteral("Size of the region."),
+                                        QStringLiteral("WxH"),
+                                        QStringLiteral("800x600"));
+    const QCommandLineOption outputOption(QStringLiteral("output"),
+                                          QStringLiteral("File to write GIF to, it's removed if not set."),
+                                          QStringLiteral("file.gif"));
+
+    parser.addOptions({sourceOption, secondsOption, fpsOption, sizeOption, outputOption});
+    parser.process(app);
+
+    const auto source = parser.value(sourceOption);
+    bool secondsOk = false;
+    bool fpsOk = false;
+    const auto seconds = parser.value(secondsOption).toInt(&secondsOk);
+    const auto fps = parser.value(fpsOption).toInt(&fpsOk);
+    const auto wh = parser.value(sizeOption).split(QLatin1Char('x'));
+    const QSize size(wh.size() == 2 ? wh.at(0).toInt() : 0, wh.size() == 2 ? wh.at(1).toInt() : 0);
+
+    if ((source != QStringLiteral("synthetic") && source != QStringLiteral("grab")) || !secondsOk || seconds < 1
+        || !fpsOk || fps < 1 || size.isEmpty()) {
+        err << parser.helpText() << Qt::flush;
+
+        return 1;
+    }
+
+    auto screen = QGuiApplication::primaryScreen();
+
+    if (!screen) {
+        err << QStringLiteral("There is no screen.") << Qt::endl;
+
+        return 2;
+    }
+
+    CaptureSettings settings;
+    settings.m_screen = screen;
+    settings.m_rect = QRect(screen->geometry().topLeft(), size);
+    settings.m_fps = fps;
+    settings.m_grabCursor = false;
+    settings.m_drawMouseClick = false;
+    settings.m_grabKeys = false;
+
+    if (source == QStringLiteral("synthetic")) {
+        settings.m_source = []() {
+            return std::unique_ptr<CaptureBackend>(new SyntheticSource);
+        };
+    } else if (!screen->geometry().contains(settings.m_rect)) {
+        err << QStringLiteral("Region doesn't fit the screen.") << Qt::endl;
+
+        return 1;
+    }
+
+    const auto fileName = (parser.isSet(outputOption)
+                               ? parser.value(outputOption)
+                               : QDir::tempPath() + QDir::separator()
+                                   + QStringLiteral("gif-recorder-bench-%1.gif").arg(QCoreApplication::applicationPid()));
+
+    Capture capture;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    capture.start(settings);
+    QThread::sleep(static_cast<unsigned long>(seconds));
+    capture.stop();
+
+    const auto captureMs = timer.restart();
+
+    const auto saved = capture.save(fileName);
+
+    const auto saveMs = timer.elapsed();
+
+    // Delays are between written frames, they should be equal to the interval of ticks.
+    const auto &delays = capture.delays();
+    const auto target = 1000.0 / fps;
+    double sum = 0.0;
+    double squares = 0.0;
+    double maxDeviation = 0.0;
+
+    for (const auto d : delays) {
+        const auto deviation = d - target;
+
+        sum += d;
+        squares += deviation * deviation;
+        maxDeviation = qMax(maxDeviation, std::abs(deviation));
+    }
+
+    const auto frames = capture.frames().count();
+    qint64 pixels = 0;
+
+    for (qsizetype i = 0; i < frames; ++i) {
+        const auto s = capture.frames().size(i);
+        pixels += static_cast<qint64>(s.width()) * s.height();
+    }
+
+    // Encoding goes during capture, so throughput is counted for the whole pipeline.
+    const auto pipelineSeconds = (captureMs + saveMs) / 1000.0;
+
+    QJsonObject result;
+    result[QStringLiteral("source")] = source;
+    result[QStringLiteral("width")] = size.width();
+    result[QStringLiteral("height")] = size.height();
+    result[QStringLiteral("targetFps")] = fps;
+    result[QStringLiteral("seconds")] = captureMs / 1000.0;
+    result[QStringLiteral("capturedFrames")] = capture.capturedFrames();
+    result[QStringLiteral("writtenFrames")] = frames;
+    result[QStringLiteral("duplicateFrames")] = capture.duplicateFrames();
+    result[QStringLiteral("droppedTicks")] = capture.droppedFrames();
+    result[QStringLiteral("achievedFps")] = capture.capturedFrames() * 1000.0 / qMax<qint64>(1, captureMs);
+    result[QStringLiteral("meanDelayMs")] = (delays.isEmpty() ? 0.0 : sum / delays.size());
+    result[QStringLiteral("delayJitterMs")] = (delays.isEmpty() ? 0.0 : std::sqrt(squares / delays.size()));
+    result[QStringLiteral("maxDelayDeviationMs")] = maxDeviation;
+    result[QStringLiteral("saveAfterStopMs")] = saveMs;
+    result[QStringLiteral("encodeFramesPerSecond")] = frames / pipelineSeconds;
+    result[QStringLiteral("encodeMegapixelsPerSecond")] = pixels / 1000000.0 / pipelineSeconds;
+    result[QStringLiteral("gifBytes")] = QFileInfo(fileName).size();
+    result[QStringLiteral("peakRssBytes")] = peakRss();
+    result[QStringLiteral("saved")] = saved;
+
+    QTextStream(stdout) << QJsonDocument(result).toJson(QJsonDocument::Indented) << Qt::flush;
+
+    if (!parser.isSet(outputOption)) {
+        QFile::remove(fileName);
+    }
+
+    return (saved ? 0 : 3);
+}
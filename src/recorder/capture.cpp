@@ -0,0 +1,867 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF recorder include.
+#include "capture.hpp"
+#include "capture_backend.hpp"
+#include "cursor_tracker.hpp"
+#include "damage_tracker.hpp"
+#include "downscale.hpp"
+#include "frame_composer.hpp"
+#include "frame_hash.hpp"
+#include "frame_ring.hpp"
+#include "frame_store.hpp"
+#include "gif_writer.hpp"
+#include "overlay_compositor.hpp"
+#include "project_exporter.hpp"
+#include "replay_buffer.hpp"
+#include "stream_encoder.hpp"
+
+// Qt include.
+#include <QElapsedTimer>
+#include <QScreen>
+#include <QSet>
+#include <QThread>
+
+// C++ include.
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+//! Count of frames that may wait for writing.
+static const qsizetype s_ringCapacity = 8;
+//! How long writer waits for a frame before checking whether capture is finished, in milliseconds.
+static const int s_readTimeout = 50;
+//! After how long without input and changes on the screen capture slows down, in milliseconds.
+static const qint64 s_idleTimeout = 2000;
+//! How many frames may wait for compression before capture skips ticks.
+static const qsizetype s_maxPackingBacklog = 32;
+//! How long key is drawn after release, in milliseconds.
+static const qint64 s_keyLinger = 500;
+
+class CapturePrivate;
+
+//
+// GrabThread
+//
+
+//! Thread that grabs frames.
+class GrabThread final : public QThread
+{
+public:
+    explicit GrabThread(CapturePrivate *d)
+        : m_d(d)
+    {
+    }
+
+protected:
+    void run() override;
+
+private:
+    CapturePrivate *m_d;
+}; // class GrabThread
+
+//
+// WriteThread
+//
+
+//! Thread that writes grabbed frames.
+class WriteThread final : public QThread
+{
+public:
+    explicit WriteThread(CapturePrivate *d)
+        : m_d(d)
+    {
+    }
+
+protected:
+    void run() override;
+
+private:
+    CapturePrivate *m_d;
+}; // class WriteThread
+
+//
+// CapturePrivate
+//
+
+class CapturePrivate
+{
+public:
+    CapturePrivate(Capture *parent)
+        : m_grabThread(this)
+        , m_writeThread(this)
+        , m_encoder(m_frames, m_track)
+        , m_q(parent)
+    {
+    }
+
+    //! Grab frames on ticks of the scheduler till stop is requested.
+    void grabLoop();
+    //! Grab one frame into the ring.
+    void grabFrame(qint64 timestamp);
+    //! Grab \a part of the area into the canvas.
+    void grabCanvas(const QRect &part);
+    //! Apply input events that happened till \a timestamp.
+    void drainEvents(qint64 timestamp);
+    //! \return State of overlays at \a timestamp, \a rect is set to the area of all of them.
+    OverlaySample overlays(qint64 timestamp,
+                           QRect &rect);
+    //! \return Id of the cursor sprite, new sprites are added to the track.
+    quint64 cursorId(const MouseCursor &cursor);
+    //! Write frames from the ring till grabbing is finished.
+    void writeLoop();
+    //! \return Is the frame the same as the previous one. Remembers the frame if it's not.
+    bool isDuplicate(const FrameSlot &slot);
+    //! \return Are only the last frames kept.
+    bool isReplay() const
+    {
+        return m_settings.m_replayDuration > 0;
+    }
+
+    //! Settings.
+    CaptureSettings m_settings;
+    //! Ring of grabbed frames.
+    std::unique_ptr<FrameRing> m_ring;
+    //! Source of pixels, lives in the grab thread.
+    std::unique_ptr<CaptureBackend> m_backend;
+    //! Mouse cursor tracker, lives in the grab thread.
+    std::unique_ptr<CursorTracker> m_cursor;
+    //! Damage tracker, lives in the grab thread.
+    std::unique_ptr<DamageTracker> m_damage;
+    //! Grab area in device pixels, lives in the grab thread.
+    QRect m_native;
+    //! Current screen content without overlays in device pixels, lives in the grab thread.
+    QImage m_canvas;
+    //! Changed part of the frame that wasn't written yet because the ring was full.
+    QRect m_pending;
+    //! Compositor of overlays, used only for their area, lives in the grab thread.
+    OverlayCompositor m_compositor;
+    //! Ids of cursors added to the track, lives in the grab thread.
+    QSet<quint64> m_knownCursors;
+    //! Keys added to the track, lives in the grab thread.
+    QSet<quint32> m_knownKeys;
+    //! Rect of overlays on the previous frame, in pixels of the frame.
+    QRect m_lastOverlays;
+    //! Time since start of the capture.
+    QElapsedTimer m_clock;
+    //! Time of the end of grabbing in milliseconds since start.
+    qint64 m_endTimestamp = 0;
+    //! Grab thread.
+    GrabThread m_grabThread;
+    //! Write thread.
+    WriteThread m_writeThread;
+    //! Stop was requested.
+    std::atomic_bool m_stopRequested{false};
+    //! Grab thread is finished.
+    std::atomic_bool m_grabFinished{false};
+    //! Start of grabbing on the clock of input events, in nanoseconds.
+    qint64 m_start = 0;
+    //! Count of pressed mouse buttons, lives in the grab thread.
+    int m_buttonsPressed = 0;
+    //! Last pressed key, lives in the grab thread.
+    quint32 m_key = 0;
+    //! Is the last key still pressed.
+    bool m_keyDown = false;
+    //! Time of release of the last key in milliseconds since start.
+    qint64 m_keyReleased = 0;
+    //! Time of the last input event in milliseconds since start.
+    qint64 m_lastInput = 0;
+    //! Count of captured frames.
+    std::atomic<qint64> m_captured{0};
+    //! Count of dropped ticks.
+    std::atomic<qint64> m_dropped{0};
+    //! Count of frames merged into the previous ones as duplicates.
+    std::atomic<qint64> m_duplicates{0};
+    //! Timestamp of the last written frame that differs from the previous one.
+    std::atomic<qint64> m_lastChange{0};
+    //! Last written frame as whole, lives in the write thread.
+    QImage m_previous;
+    //! Rect of the last written frame.
+    QRect m_lastRect;
+    //! Fingerprint of the last written frame.
+    quint64 m_lastHash = 0;
+    //! Overlays of the last written frame.
+    OverlaySample m_lastOverlay;
+    //! Is any frame written.
+    bool m_written = false;
+    //! Frames.
+    FrameStore m_frames;
+    //! Overlays of frames.
+    OverlayTrack m_track;
+    //! Overlays drawn on saving.
+    OverlayOptions m_overlayOptions;
+    //! Last frames of replay mode.
+    ReplayBuffer m_replay;
+    //! Encoder of GIF.
+    StreamEncoder m_encoder;
+    //! Timestamps of frames.
+    QVector<qint64> m_timestamps;
+    //! Delays.
+    QVector<int> m_delays;
+    //! Parent.
+    Capture *m_q;
+}; // class CapturePrivate
+
+void CapturePrivate::grabLoop()
+{
+    using Clock = std::chrono::steady_clock;
+
+    const auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(
+        1000000000LL / qMax(1, m_settings.m_fps)));
+    const auto &r = m_settings.m_rect;
+
+    m_native = nativeRect(m_settings.m_screen, r);
+
+    const auto size = m_native.size();
+
+    if (m_settings.m_source) {
+        m_backend = m_settings.m_source();
+    } else {
+        m_backend = CaptureBackend::create(m_settings.m_screen, r, size);
+        m_damage.reset(new DamageTracker(m_native));
+    }
+    m_canvas = QImage(size, QImage::Format_RGB32);
+    m_canvas.fill(Qt::black);
+    m_pending = {};
+    m_lastOverlays = {};
+
+    // Cursor is tracked even if it's not drawn, so it can be turned on after recording.
+    m_cursor.reset(new CursorTracker);
+    m_knownCursors.clear();
+    m_knownKeys.clear();
+
+    const auto idleInterval = std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(
+        1000000000LL / qMax(1, qMin(m_settings.m_idleFps, m_settings.m_fps))));
+    const auto start = Clock::now();
+    qint64 tick = 0;
+    auto lastGrab = start - idleInterval;
+    QPoint cursorPos;
+
+    m_start = std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count();
+    m_buttonsPressed = 0;
+    m_key = 0;
+    m_keyDown = false;
+    m_lastInput = 0;
+
+    while (!m_stopRequested.load(std::memory_order_acquire)) {
+        // Deadlines are counted from the start, so latency of one tick doesn't shift the following ones.
+        const auto deadline = start + interval * tick;
+        const auto now = Clock::now();
+
+        if (now < deadline) {
+            std::this_thread::sleep_until(deadline);
+
+            continue;
+        }
+
+        // We are late for whole ticks, skip them. Delays are taken from timestamps,
+        // so previous frame will just last longer.
+        const auto late = static_cast<qint64>((now - deadline) / interval);
+
+        if (late > 0) {
+            m_dropped += late;
+            tick += late;
+        }
+
+        ++tick;
+
+        const auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count();
+
+        drainEvents(timestamp);
+
+        if (m_settings.m_adaptiveFps) {
+            // Input and cursor moves are checked on every tick, they are cheap and wake up capture at once.
+            const auto currentPos = (m_cursor ? m_cursor->position() : QPoint());
+
+            if (currentPos != cursorPos) {
+                cursorPos = currentPos;
+                m_lastInput = timestamp;
+            }
+
+            const auto idle = (timestamp - qMax(m_lastInput, m_lastChange.load()) > s_idleTimeout);
+
+            if (idle && now - lastGrab < idleInterval) {
+                continue;
+            }
+        }
+
+        // Compression can't keep up, lower the rate instead of piling up frames in memory.
+        // Damage isn't fetched, so changes of the skipped tick go to the next frame.
+        if (m_frames.packingBacklog() > s_maxPackingBacklog) {
+            ++m_dropped;
+
+            continue;
+        }
+
+        lastGrab = now;
+
+        grabFrame(timestamp);
+    }
+
+    m_endTimestamp = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+
+    m_cursor.reset();
+    m_damage.reset();
+    m_backend.reset();
+    m_canvas = {};
+}
+
+void CapturePrivate::grabFrame(qint64 timestamp)
+{
+    const auto damage = (m_damage ? m_damage->damage() : m_canvas.rect()) & m_canvas.rect();
+
+    grabCanvas(damage);
+
+    QRect overlaysRect;
+    const auto overlay = overlays(timestamp, overlaysRect);
+    const auto frameRect = QRect(QPoint(0, 0), m_ring->frameSize());
+
+    // Overlays are redrawn on encoding where they were and where they are now.
+    const auto dirty =
+        (m_pending | downscaledRect(damage, m_settings.m_downscale) | overlaysRect | m_lastOverlays) & frameRect;
+
+    m_lastOverlays = overlaysRect;
+
+    // Nothing changed, previous frame will just last longer.
+    if (dirty.isEmpty()) {
+        return;
+    }
+
+    auto slot = m_ring->beginWrite();
+
+    if (!slot) {
+        m_pending = dirty;
+        ++m_dropped;
+
+        return;
+    }
+
+    m_pending = {};
+
+    // Only the pixels that will be stored are produced, right in the slot.
+    downscale(m_canvas, slot->m_image, dirty, m_settings.m_downscale);
+
+    slot->m_overlay = overlay;
+    slot->m_rect = dirty;
+    slot->m_timestamp = timestamp;
+
+    m_ring->endWrite();
+
+    ++m_captured;
+}
+
+void CapturePrivate::grabCanvas(const QRect &part)
+{
+    if (part.isEmpty()) {
+        return;
+    }
+
+    const auto &r = m_settings.m_rect;
+
+    if (!m_backend->grab(r, m_canvas, part)) {
+        // Native backend can fail in the middle, e.g. when screen configuration changes.
+        m_backend.reset(new QtCaptureBackend(m_settings.m_screen));
+        m_backend->grab(r, m_canvas, part);
+    }
+}
+
+void CapturePrivate::drainEvents(qint64 timestamp)
+{
+    if (!m_settings.m_events) {
+        return;
+    }
+
+    InputEvent e;
+
+    while (m_settings.m_events->pop(e)) {
+        const auto t = (e.m_timestamp - m_start) / 1000000;
+
+        // Left from the time when nothing was recorded.
+        if (t < 0) {
+            continue;
+        }
+
+        m_lastInput = qMin(t, timestamp);
+
+        auto recorded = e;
+        recorded.m_timestamp = m_lastInput;
+        m_track.appendEvent(recorded);
+
+        switch (e.m_type) {
+        case InputEvent::ButtonPress:
+            ++m_buttonsPressed;
+            break;
+
+        case InputEvent::ButtonRelease:
+            m_buttonsPressed = qMax(0, m_buttonsPressed - 1);
+            break;
+
+        case InputEvent::KeyPress:
+            m_key = e.m_key;
+            m_keyDown = true;
+            break;
+
+        case InputEvent::KeyRelease:
+            if (e.m_key == m_key) {
+                m_keyDown = false;
+                m_keyReleased = m_lastInput;
+            }
+            break;
+        }
+    }
+}
+
+OverlaySample CapturePrivate::overlays(qint64 timestamp,
+                                       QRect &rect)
+{
+    OverlaySample s;
+    MouseCursor cursor;
+    QString key;
+
+    // Everything is recorded, options only decide what is drawn on encoding.
+    if (m_cursor) {
+        cursor = m_cursor->cursor(m_native, m_canvas);
+
+        const auto f = m_settings.m_downscale;
+
+        if (f > 1) {
+            cursor.m_rect = (cursor.m_rect.isEmpty()
+                                 ? QRect()
+                                 : QRect(cursor.m_rect.topLeft() / f, (cursor.m_rect.size() / f).expandedTo({1, 1})));
+            cursor.m_hotSpot /= f;
+        }
+
+        s.m_cursorRect = cursor.m_rect;
+        s.m_hotSpot = cursor.m_hotSpot;
+        s.m_click = (m_buttonsPressed > 0);
+
+        if (!cursor.m_image.isNull()) {
+            s.m_cursor = cursorId(cursor);
+        }
+    }
+
+    if (m_settings.m_events && m_key && (m_keyDown || timestamp - m_keyReleased < s_keyLinger)) {
+        key = m_settings.m_events->keyName(m_key);
+        s.m_key = m_key;
+
+        if (!m_knownKeys.contains(m_key)) {
+            m_knownKeys.insert(m_key);
+            m_track.addKey(m_key, key);
+        }
+    }
+
+    // Sprite of the cursor isn't needed for the area.
+    cursor.m_image = {};
+
+    rect = m_compositor.layout(cursor, s.m_click, key, m_ring->frameSize()).m_rect;
+
+    return s;
+}
+
+quint64 CapturePrivate::cursorId(const MouseCursor &cursor)
+{
+    if (cursor.m_serial && m_knownCursors.contains(cursor.m_serial)) {
+        return cursor.m_serial;
+    }
+
+    auto sprite = (cursor.m_image.format() == QImage::Format_ARGB32_Premultiplied
+                       ? cursor.m_image
+                       : cursor.m_image.convertToFormat(QImage::Format_ARGB32_Premultiplied));
+
+    // Sprite is reduced as frames are.
+    if (sprite.size() != cursor.m_rect.size()) {
+        sprite = sprite.scaled(cursor.m_rect.size(), Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+
+    // Without serial the same sprite is recognized by its pixels.
+    const quint64 id = (cursor.m_serial ? cursor.m_serial : frameHash(sprite, sprite.rect()) | (1ULL << 63));
+
+    if (!m_knownCursors.contains(id)) {
+        m_knownCursors.insert(id);
+        m_track.addCursor(id, sprite);
+    }
+
+    return id;
+}
+
+void CapturePrivate::writeLoop()
+{
+    m_previous = QImage(m_ring->frameSize(), QImage::Format_RGB32);
+    m_lastRect = {};
+    m_lastHash = 0;
+    m_lastOverlay = {};
+    m_written = false;
+
+    while (true) {
+        auto slot = m_ring->beginRead(s_readTimeout);
+
+        if (!slot) {
+            if (m_grabFinished.load(std::memory_order_acquire) && m_ring->isEmpty()) {
+                break;
+            }
+
+            continue;
+        }
+
+        // Duplicate is skipped, so the previous frame lasts longer.
+        if (!isDuplicate(*slot)) {
+            if (isReplay()) {
+                // Events of dropped frames won't be saved, so they don't pile up.
+                m_track.removeEventsBefore(
+                    m_replay.append(slot->m_image, slot->m_rect, slot->m_timestamp, slot->m_overlay));
+                m_lastChange = slot->m_timestamp;
+            } else if (m_frames.append(slot->m_image, slot->m_rect)) {
+                // Sample goes before the encoder learns about the frame.
+                m_track.append(slot->m_overlay);
+                m_timestamps.push_back(slot->m_timestamp);
+                m_encoder.addFrame(slot->m_timestamp);
+                m_lastChange = slot->m_timestamp;
+            }
+        }
+
+        m_ring->endRead();
+    }
+
+    m_previous = {};
+}
+
+bool CapturePrivate::isDuplicate(const FrameSlot &slot)
+{
+    const auto &r = slot.m_rect;
+    const auto hash = frameHash(slot.m_image, r);
+
+    // Different fingerprints of the same area prove the change, anything else is verified.
+    // Frames are clean, so moved cursor or new key make the frame different too.
+    if (m_written && slot.m_overlay == m_lastOverlay && !(r == m_lastRect && hash != m_lastHash)
+        && samePixels(slot.m_image, m_previous, r)) {
+        ++m_duplicates;
+
+        return true;
+    }
+
+    m_lastRect = r;
+    m_lastHash = hash;
+    m_lastOverlay = slot.m_overlay;
+    m_written = true;
+
+    const auto bytes = static_cast<size_t>(r.width()) * 4;
+
+    for (int y = r.top(); y <= r.bottom(); ++y) {
+        std::memcpy(reinterpret_cast<QRgb *>(m_previous.scanLine(y)) + r.x(),
+                    reinterpret_cast<const QRgb *>(slot.m_image.constScanLine(y)) + r.x(),
+                    bytes);
+    }
+
+    return false;
+}
+
+void GrabThread::run()
+{
+    m_d->grabLoop();
+}
+
+void WriteThread::run()
+{
+    m_d->writeLoop();
+}
+
+//
+// Capture
+//
+
+Capture::Capture(QObject *parent)
+    : QObject(parent)
+    , m_d(new CapturePrivate(this))
+{
+    connect(&m_d->m_encoder, &StreamEncoder::writeProgress, this, &Capture::writeProgress);
+}
+
+Capture::~Capture()
+{
+    stop();
+}
+
+void Capture::start(const CaptureSettings &settings)
+{
+    if (isRunning()) {
+        return;
+    }
+
+    clear();
+
+    m_d->m_settings = settings;
+    m_d->m_stopRequested = false;
+    m_d->m_grabFinished = false;
+    m_d->m_captured = 0;
+    m_d->m_dropped = 0;
+    m_d->m_duplicates = 0;
+    m_d->m_lastChange = 0;
+    m_d->m_clock.start();
+    m_d->m_frames.setMemoryBudget(settings.m_memoryBudget);
+    m_d->m_settings.m_downscale = qMax(1, settings.m_downscale);
+
+    const auto native = nativeRect(settings.m_screen, settings.m_rect).size();
+    const auto f = m_d->m_settings.m_downscale;
+
+    m_d->m_ring.reset(new FrameRing(s_ringCapacity,
+                                    QSize(qMax(1, native.width() / f), qMax(1, native.height() / f)),
+                                    QImage::Format_RGB32));
+    m_d->m_track.setFrameSize(m_d->m_ring->frameSize());
+
+    m_d->m_overlayOptions.m_cursor = settings.m_grabCursor;
+    m_d->m_overlayOptions.m_clicks = settings.m_drawMouseClick;
+    m_d->m_overlayOptions.m_keys = settings.m_grabKeys;
+
+    if (m_d->isReplay()) {
+        m_d->m_replay.reset(m_d->m_ring->frameSize(), settings.m_replayDuration, settings.m_memoryBudget);
+    } else if (settings.m_paletteMode != PaletteMode::Global) {
+        // Without the partial file GIF is written from the store on save.
+        m_d->m_encoder.begin(m_d->m_ring->frameSize(), m_d->m_overlayOptions, settings.m_paletteMode);
+    }
+
+    m_d->m_writeThread.start();
+    m_d->m_grabThread.start(QThread::HighPriority);
+}
+
+void Capture::stop()
+{
+    if (!isRunning()) {
+        return;
+    }
+
+    m_d->m_stopRequested = true;
+    m_d->m_grabThread.wait();
+    m_d->m_grabFinished = true;
+    m_d->m_writeThread.wait();
+    m_d->m_ring.reset();
+    m_d->m_encoder.finish(m_d->m_endTimestamp);
+
+    m_d->m_delays.clear();
+
+    // Frames are written only on changes, so the last one lasts till the end of recording.
+    for (qsizetype i = 0; i < m_d->m_timestamps.size(); ++i) {
+        const auto next = (i + 1 < m_d->m_timestamps.size() ? m_d->m_timestamps[i + 1] : m_d->m_endTimestamp);
+
+        m_d->m_delays.push_back(static_cast<int>(next - m_d->m_timestamps[i]));
+    }
+}
+
+bool Capture::isRunning() const
+{
+    return (m_d->m_grabThread.isRunning() || m_d->m_writeThread.isRunning());
+}
+
+bool Capture::save(const QString &fileName,
+                   QPromise<bool> *promise)
+{
+    if (m_d->isReplay()) {
+        return saveReplay(fileName, promise);
+    }
+
+    if (m_d->m_encoder.isActive()) {
+        if (m_d->m_encoder.options() == m_d->m_overlayOptions) {
+            return m_d->m_encoder.save(fileName, promise);
+        }
+
+        // Overlays were changed after recording, frames are encoded again.
+        m_d->m_encoder.discard();
+    }
+
+    FrameComposer frames(m_d->m_frames, m_d->m_track);
+    frames.setOptions(m_d->m_overlayOptions);
+
+    GifWriter writer;
+    writer.setPaletteMode(m_d->m_settings.m_paletteMode);
+
+    connect(&writer, &GifWriter::writeProgress, this, &Capture::writeProgress);
+
+    return writer.write(fileName, frames, m_d->m_delays, 0, promise);
+}
+
+bool Capture::saveReplay(const QString &fileName,
+                         QPromise<bool> *promise)
+{
+    const auto frames = m_d->m_replay.snapshot();
+
+    if (frames.count() == 0) {
+        if (promise) {
+            promise->addResult(false);
+        }
+
+        return false;
+    }
+
+    // The last frame lasts till now if capture goes on.
+    const auto end = (isRunning() ? m_d->m_clock.elapsed() : m_d->m_endTimestamp);
+
+    OverlayTrack track;
+    track.copySprites(m_d->m_track);
+
+    for (const auto &s : frames.overlays()) {
+        track.append(s);
+    }
+
+    FrameComposer composer(frames, track);
+    composer.setOptions(m_d->m_overlayOptions);
+
+    GifWriter writer;
+    writer.setPaletteMode(m_d->m_settings.m_paletteMode);
+
+    return writer.write(fileName, composer, frames.delays(end), 0, promise);
+}
+
+namespace /* anonymous */
+{
+
+//! \return Events of the track from \a start in milliseconds, relative to it.
+QVector<ProjectEvent> projectEvents(const QVector<InputEvent> &events,
+                                    qint64 start)
+{
+    QVector<ProjectEvent> res;
+    res.reserve(events.size());
+
+    for (const auto &e : events) {
+        if (e.m_timestamp < start) {
+            continue;
+        }
+
+        ProjectEvent p;
+        p.m_timestamp = e.m_timestamp - start;
+        p.m_key = e.m_key;
+        p.m_type = static_cast<ProjectEvent::Type>(e.m_type);
+        p.m_button = e.m_button;
+
+        res.push_back(p);
+    }
+
+    return res;
+}
+
+} /* namespace anonymous */
+
+bool Capture::saveProject(const QString &fileName,
+                          QPromise<bool> *promise)
+{
+    ProjectExporter exporter;
+
+    return writeProject(exporter, fileName, promise);
+}
+
+bool Capture::shareProject(const QString &name,
+                           QPromise<bool> *promise)
+{
+    ProjectExporter exporter;
+    exporter.setShared(true);
+
+    return writeProject(exporter, name, promise);
+}
+
+bool Capture::writeProject(ProjectExporter &exporter,
+                           const QString &fileName,
+                           QPromise<bool> *promise)
+{
+    connect(&exporter, &ProjectExporter::writeProgress, this, &Capture::writeProgress);
+
+    if (m_d->isReplay()) {
+        const auto frames = m_d->m_replay.snapshot();
+        const auto end = (isRunning() ? m_d->m_clock.elapsed() : m_d->m_endTimestamp);
+
+        OverlayTrack track;
+        track.copySprites(m_d->m_track);
+
+        for (const auto &s : frames.overlays()) {
+            track.append(s);
+        }
+
+        FrameComposer composer(frames, track);
+        composer.setOptions(m_d->m_overlayOptions);
+
+        return exporter.write(fileName,
+                              composer,
+                              frames.delays(end),
+                              projectEvents(m_d->m_track.events(), frames.timestamp(0)),
+                              track.keyNames(),
+                              promise);
+    }
+
+    FrameComposer composer(m_d->m_frames, m_d->m_track);
+    composer.setOptions(m_d->m_overlayOptions);
+
+    return exporter.write(fileName,
+                          composer,
+                          m_d->m_delays,
+                          projectEvents(m_d->m_track.events(), m_d->m_timestamps.value(0)),
+                          m_d->m_track.keyNames(),
+                          promise);
+}
+
+void Capture::clear()
+{
+    // Encoder reads the store.
+    m_d->m_encoder.discard();
+    m_d->m_frames.clear();
+    m_d->m_track.clear();
+    m_d->m_replay.clear();
+    m_d->m_timestamps.clear();
+    m_d->m_delays.clear();
+}
+
+qint64 Capture::capturedFrames() const
+{
+    return m_d->m_captured.load(std::memory_order_relaxed);
+}
+
+qint64 Capture::droppedFrames() const
+{
+    return m_d->m_dropped.load(std::memory_order_relaxed);
+}
+
+qint64 Capture::duplicateFrames() const
+{
+    return m_d->m_duplicates.load(std::memory_order_relaxed);
+}
+
+CaptureStats Capture::stats() const
+{
+    CaptureStats s;
+    s.m_elapsed = (m_d->m_clock.isValid() ? m_d->m_clock.elapsed() : 0);
+    s.m_captured = capturedFrames();
+    s.m_dropped = droppedFrames();
+    s.m_duplicates = duplicateFrames();
+    s.m_memory = (m_d->isReplay() ? m_d->m_replay.memoryUsage() : m_d->m_frames.memoryUsage());
+    s.m_spilled = m_d->m_frames.spilledBytes();
+    s.m_encoderBacklog = m_d->m_encoder.backlog();
+    s.m_packingBacklog = m_d->m_frames.packingBacklog();
+
+    return s;
+}
+
+const FrameStore &Capture::frames() const
+{
+    return m_d->m_frames;
+}
+
+const QVector<int> &Capture::delays() const
+{
+    return m_d->m_delays;
+}
+
+const OverlayTrack &Capture::overlayTrack() const
+{
+    return m_d->m_track;
+}
+
+OverlayOptions Capture::overlayOptions() const
+{
+    return m_d->m_overlayOptions;
+}
+
+void Capture::setOverlayOptions(const OverlayOptions &o)
+{
+    m_d->m_overlayOptions = o;
+}
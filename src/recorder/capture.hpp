@@ -0,0 +1,173 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QObject>
+#include <QPromise>
+#include <QRect>
+#include <QScopedPointer>
+#include <QVector>
+
+// GIF recorder include.
+#include "capture_backend.hpp"
+#include "frame_store.hpp"
+#include "gif_writer.hpp"
+#include "input_events.hpp"
+#include "overlay_track.hpp"
+
+// C++ include.
+#include <functional>
+#include <memory>
+
+class QScreen;
+class ProjectExporter;
+
+//
+// CaptureSettings
+//
+
+//! Settings of the capture.
+struct CaptureSettings {
+    //! Screen to grab.
+    QScreen *m_screen = nullptr;
+    //! Grab area in global coordinates.
+    QRect m_rect;
+    //! Frames are reduced this many times in both directions while grabbing, e.g. 2 records
+    //! the screen with device pixel ratio 2 in logical pixels.
+    int m_downscale = 1;
+    //! Frames per second. Maximum if frame rate is adaptive.
+    int m_fps = 24;
+    //! Slow down to the keep-alive rate when nothing happens.
+    bool m_adaptiveFps = false;
+    //! Frames per second when nothing happens.
+    int m_idleFps = 2;
+    //! Draw mouse cursor. Overlays are always recorded, these are initial options of drawing them.
+    bool m_grabCursor = true;
+    //! Draw mouse clicks.
+    bool m_drawMouseClick = true;
+    //! Draw keyboard keys presses.
+    bool m_grabKeys = false;
+    //! Input events for clicks and keys, drained by the capture on every tick.
+    InputEvents *m_events = nullptr;
+    //! Memory for frames, in bytes. Frames above the budget go to the disk.
+    qint64 m_memoryBudget = FrameStore::s_defaultMemoryBudget;
+    //! Mode of palettes of GIF. Global palette is known only at the end, so GIF isn't encoded
+    //! while recording in this mode.
+    PaletteMode m_paletteMode = PaletteMode::Stable;
+    //! Keep only the last this many milliseconds of frames compressed in memory, 0 to keep everything.
+    //! Frames above the memory budget are dropped too in this mode.
+    qint64 m_replayDuration = 0;
+    //! Source of frames instead of the screen, e.g. for benchmarks. Called in the grab thread.
+    //! All pixels of the source are treated as changed on every frame.
+    std::function<std::unique_ptr<CaptureBackend>()> m_source;
+}; // struct CaptureSettings
+
+//
+// CaptureStats
+//
+
+//! Statistics of the capture.
+struct CaptureStats {
+    //! Time since start of the capture, in milliseconds.
+    qint64 m_elapsed = 0;
+    //! Count of captured frames.
+    qint64 m_captured = 0;
+    //! Count of dropped ticks.
+    qint64 m_dropped = 0;
+    //! Count of frames merged into the previous ones.
+    qint64 m_duplicates = 0;
+    //! Bytes of frames in memory.
+    qint64 m_memory = 0;
+    //! Bytes of compressed frames on the disk.
+    qint64 m_spilled = 0;
+    //! Count of frames waiting for GIF encoder.
+    qint64 m_encoderBacklog = 0;
+    //! Count of frames waiting for compression.
+    qint64 m_packingBacklog = 0;
+}; // struct CaptureStats
+
+//
+// Capture
+//
+
+class CapturePrivate;
+
+//! Screen capture. Frames are grabbed in a dedicated thread and written in another one,
+//! GIF is encoded during capturing in a third one.
+class Capture final : public QObject
+{
+    Q_OBJECT
+
+signals:
+    //! Progress of saving in percents.
+    void writeProgress(int percent);
+
+public:
+    explicit Capture(QObject *parent = nullptr);
+    ~Capture() override;
+
+    //! Start capturing.
+    void start(const CaptureSettings &settings);
+    //! Stop capturing. Returns when all grabbed frames are written, GIF is still encoded in background.
+    void stop();
+    //! Finish GIF and save it to \a fileName. Should be called after stop(), may be called from any thread.
+    //! In replay mode only the last frames are saved.
+    //! Result is added to the promise if it's given.
+    bool save(const QString &fileName,
+              QPromise<bool> *promise = nullptr);
+    //! Save the last frames of replay mode to \a fileName. May be called from any thread while capture
+    //! goes on. Result is added to the promise if it's given.
+    bool saveReplay(const QString &fileName,
+                    QPromise<bool> *promise = nullptr);
+    //! Save recorded frames with overlays, their delays and input events to the project \a fileName
+    //! for the editor. Should be called after stop(), in replay mode only the last frames are saved.
+    //! Result is added to the promise if it's given.
+    bool saveProject(const QString &fileName,
+                     QPromise<bool> *promise = nullptr);
+    //! Same as saveProject(), but the project is written to the shared memory segment
+    //! with the given name, which is passed to the editor.
+    bool shareProject(const QString &name,
+                      QPromise<bool> *promise = nullptr);
+    //! \return Is capture running.
+    bool isRunning() const;
+    //! Remove captured frames.
+    void clear();
+
+    //! \return Count of captured frames.
+    qint64 capturedFrames() const;
+    //! \return Count of ticks skipped because capture was late or the ring was full.
+    qint64 droppedFrames() const;
+    //! \return Count of frames merged into the previous ones because they were the same.
+    qint64 duplicateFrames() const;
+    //! \return Statistics of the capture. Cheap enough to be polled while capturing.
+    CaptureStats stats() const;
+
+    //! \return Captured frames. Valid after stop().
+    const FrameStore &frames() const;
+    //! \return Delays of captured frames. Valid after stop().
+    const QVector<int> &delays() const;
+    //! \return Overlays of captured frames. Valid after stop().
+    const OverlayTrack &overlayTrack() const;
+
+    //! \return Overlays drawn on saving.
+    OverlayOptions overlayOptions() const;
+    //! Set overlays drawn on saving. If they differ from the ones of start(), GIF is encoded again on save().
+    void setOverlayOptions(const OverlayOptions &o);
+
+private:
+    //! Write project with the exporter.
+    bool writeProject(ProjectExporter &exporter,
+                      const QString &fileName,
+                      QPromise<bool> *promise);
+
+private:
+    friend class CapturePrivate;
+
+    Q_DISABLE_COPY(Capture)
+
+    QScopedPointer<CapturePrivate> m_d;
+}; // class Capture
@@ -0,0 +1,405 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF recorder include.
+#include "capture_backend.hpp"
+
+// Qt include.
+#include <QGuiApplication>
+#include <QScreen>
+#include <QSysInfo>
+#include <QtEndian>
+
+// C++ include.
+#include <cstring>
+
+#ifdef Q_OS_LINUX
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/extensions/XShm.h>
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace /* anonymous */
+{
+
+//! Copy \a part of \a from into the same place of the preallocated \a to without reallocation of \a to.
+void copyImage(const QImage &from,
+               QImage &to,
+               const QRect &part)
+{
+    const QImage src = (from.format() == to.format() ? from : from.convertToFormat(to.format()));
+    const auto r = part & src.rect() & to.rect();
+    const auto pixel = static_cast<size_t>(to.depth() / 8);
+    const auto bytes = static_cast<size_t>(r.width()) * pixel;
+
+    for (int y = r.top(); y <= r.bottom(); ++y) {
+        std::memcpy(to.scanLine(y) + r.x() * pixel, src.constScanLine(y) + r.x() * pixel, bytes);
+    }
+}
+
+#ifdef Q_OS_LINUX
+
+//! Copy \a count pixels from \a src to \a dst making them opaque, bytes are swapped if \a swap.
+void fixupLine(const quint32 *src,
+               quint32 *dst,
+               int count,
+               bool swap)
+{
+    int x = 0;
+
+    if (swap) {
+#if defined(__SSSE3__)
+        const __m128i order = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xff000000u));
+
+        for (; x + 4 <= count; x += 4) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), _mm_or_si128(_mm_shuffle_epi8(v, order), alpha));
+        }
+#elif defined(__ARM_NEON)
+        const uint32x4_t alpha = vdupq_n_u32(0xff000000u);
+
+        for (; x + 4 <= count; x += 4) {
+            const uint32x4_t v = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(vld1q_u32(src + x))));
+            vst1q_u32(dst + x, vorrq_u32(v, alpha));
+        }
+#endif
+
+        for (; x < count; ++x) {
+            dst[x] = qbswap(src[x]) | 0xff000000u;
+        }
+    } else {
+#if defined(__SSE2__)
+        const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xff000000u));
+
+        for (; x + 4 <= count; x += 4) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), _mm_or_si128(v, alpha));
+        }
+#elif defined(__ARM_NEON)
+        const uint32x4_t alpha = vdupq_n_u32(0xff000000u);
+
+        for (; x + 4 <= count; x += 4) {
+            vst1q_u32(dst + x, vorrq_u32(vld1q_u32(src + x), alpha));
+        }
+#endif
+
+        for (; x < count; ++x) {
+            dst[x] = src[x] | 0xff000000u;
+        }
+    }
+}
+
+//! Convert 32 bits per pixel \a xi into the preallocated RGB32 \a image at \a pos.
+//! Byte order and alpha are fixed in the same pass with the copy.
+void qimageFromXImage(XImage *xi,
+                      QImage &image,
+                      const QPoint &pos)
+{
+    const bool swap = ((QSysInfo::ByteOrder == QSysInfo::LittleEndian && xi->byte_order == MSBFirst)
+                       || (QSysInfo::ByteOrder == QSysInfo::BigEndian && xi->byte_order == LSBFirst));
+    const auto r = QRect(pos, QSize(xi->width, xi->height)) & image.rect();
+
+    for (int y = 0; y < r.height(); ++y) {
+        fixupLine(reinterpret_cast<const quint32 *>(xi->data + static_cast<size_t>(y) * xi->bytes_per_line),
+                  reinterpret_cast<quint32 *>(image.scanLine(r.y() + y)) + r.x(),
+                  r.width(),
+                  swap);
+    }
+}
+
+//! X error happened while errors were trapped.
+bool s_xError = false;
+
+int trapXError(Display *,
+               XErrorEvent *)
+{
+    s_xError = true;
+
+    return 0;
+}
+
+//
+// XShmCaptureBackend
+//
+
+//! Backend on MIT-SHM. Server writes pixels into the shared segment that is reused for every frame.
+class XShmCaptureBackend final : public CaptureBackend
+{
+public:
+    explicit XShmCaptureBackend(QScreen *screen)
+        : m_screen(screen)
+    {
+    }
+
+    ~XShmCaptureBackend() override;
+
+    //! Connect to the display and allocate shared segment for frames of \a size.
+    //! \return false if XShm can't be used.
+    bool init(const QSize &size);
+
+    bool grab(const QRect &r,
+              QImage &img,
+              const QRect &part) override;
+
+private:
+    //! \return Image on the shared segment of the given size.
+    XImage *image(const QSize &size);
+
+private:
+    //! Screen.
+    QScreen *m_screen;
+    //! Display.
+    Display *m_display = nullptr;
+    //! Root window.
+    Window m_root = 0;
+    //! Visual of the root window.
+    Visual *m_visual = nullptr;
+    //! Depth of the root window.
+    int m_depth = 0;
+    //! Size of the root window.
+    QSize m_rootSize;
+    //! Image on the shared segment.
+    XImage *m_image = nullptr;
+    //! Image of a part of the area on the same segment.
+    XImage *m_part = nullptr;
+    //! Shared segment.
+    XShmSegmentInfo m_shm = {};
+    //! Is segment attached by the server.
+    bool m_attached = false;
+}; // class XShmCaptureBackend
+
+XShmCaptureBackend::~XShmCaptureBackend()
+{
+    if (m_attached) {
+        XShmDetach(m_display, &m_shm);
+        XSync(m_display, False);
+    }
+
+    // Data is the shared segment, don't let Xlib free it.
+    for (auto img : {m_image, m_part}) {
+        if (img) {
+            img->data = nullptr;
+            XDestroyImage(img);
+        }
+    }
+
+    if (m_shm.shmaddr) {
+        shmdt(m_shm.shmaddr);
+    }
+
+    if (m_display) {
+        XCloseDisplay(m_display);
+    }
+}
+
+bool XShmCaptureBackend::init(const QSize &size)
+{
+    m_display = XOpenDisplay(nullptr);
+
+    if (!m_display || !XShmQueryExtension(m_display)) {
+        return false;
+    }
+
+    const int screen = DefaultScreen(m_display);
+    m_root = RootWindow(m_display, screen);
+    m_visual = DefaultVisual(m_display, screen);
+    m_depth = DefaultDepth(m_display, screen);
+    m_rootSize = QSize(DisplayWidth(m_display, screen), DisplayHeight(m_display, screen));
+
+    m_image = XShmCreateImage(m_display,
+                              m_visual,
+                              m_depth,
+                              ZPixmap,
+                              nullptr,
+                              &m_shm,
+                              size.width(),
+                              size.height());
+
+    // Only 8 bits per channel is handled natively, anything else goes through Qt.
+    if (!m_image || m_image->bits_per_pixel != 32 || m_image->red_mask != 0xff0000 || m_image->green_mask != 0xff00
+        || m_image->blue_mask != 0xff) {
+        return false;
+    }
+
+    m_shm.shmid = shmget(IPC_PRIVATE, static_cast<size_t>(m_image->bytes_per_line) * m_image->height, IPC_CREAT | 0600);
+
+    if (m_shm.shmid < 0) {
+        return false;
+    }
+
+    auto addr = shmat(m_shm.shmid, nullptr, 0);
+
+    if (addr == reinterpret_cast<void *>(-1)) {
+        shmctl(m_shm.shmid, IPC_RMID, nullptr);
+
+        return false;
+    }
+
+    m_shm.shmaddr = m_image->data = static_cast<char *>(addr);
+    m_shm.readOnly = False;
+
+    // Attach fails on remote displays, default handler would terminate the application.
+    s_xError = false;
+    auto handler = XSetErrorHandler(trapXError);
+    const auto attached = XShmAttach(m_display, &m_shm);
+    XSync(m_display, False);
+    XSetErrorHandler(handler);
+
+    // Segment is destroyed when the last process detaches, even if we crash.
+    shmctl(m_shm.shmid, IPC_RMID, nullptr);
+
+    m_attached = (attached && !s_xError);
+
+    return m_attached;
+}
+
+XImage *XShmCaptureBackend::image(const QSize &size)
+{
+    if (size.width() == m_image->width && size.height() == m_image->height) {
+        return m_image;
+    }
+
+    if (!m_part || size.width() != m_part->width || size.height() != m_part->height) {
+        if (m_part) {
+            m_part->data = nullptr;
+            XDestroyImage(m_part);
+        }
+
+        // Only the header is created, pixels go to the beginning of the segment.
+        m_part = XShmCreateImage(m_display,
+                                 m_visual,
+                                 m_depth,
+                                 ZPixmap,
+                                 m_shm.shmaddr,
+                                 &m_shm,
+                                 size.width(),
+                                 size.height());
+    }
+
+    return m_part;
+}
+
+bool XShmCaptureBackend::grab(const QRect &r,
+                              QImage &img,
+                              const QRect &part)
+{
+    const QRect native(nativeRect(m_screen, r).topLeft(), QSize(m_image->width, m_image->height));
+    const auto p = part & img.rect();
+
+    if (img.size() != native.size() || img.format() != QImage::Format_RGB32
+        || !QRect(QPoint(0, 0), m_rootSize).contains(native)) {
+        return false;
+    }
+
+    if (p.isEmpty()) {
+        return true;
+    }
+
+    auto xi = image(p.size());
+
+    if (!xi || !XShmGetImage(m_display, m_root, xi, native.x() + p.x(), native.y() + p.y(), AllPlanes)) {
+        return false;
+    }
+
+    qimageFromXImage(xi, img, p.topLeft());
+
+    return true;
+}
+
+#endif // Q_OS_LINUX
+
+} /* namespace anonymous */
+
+QScreen *screenFor(const QRect &r)
+{
+    QScreen *ret = QGuiApplication::primaryScreen();
+    qint64 area = 0;
+
+    for (auto screen : QGuiApplication::screens()) {
+        const auto part = screen->geometry() & r;
+        const auto a = static_cast<qint64>(part.width()) * part.height();
+
+        if (a > area) {
+            area = a;
+            ret = screen;
+        }
+    }
+
+    return ret;
+}
+
+QRect nativeRect(QScreen *screen,
+                 const QRect &r)
+{
+    const auto origin = screen->geometry().topLeft();
+    const auto ratio = screen->devicePixelRatio();
+
+    return QRect(origin + QPoint(qRound((r.x() - origin.x()) * ratio), qRound((r.y() - origin.y()) * ratio)),
+                 r.size() * ratio);
+}
+
+//
+// CaptureBackend
+//
+
+std::unique_ptr<CaptureBackend> CaptureBackend::create(QScreen *screen,
+                                                       const QRect &r,
+                                                       const QSize &size)
+{
+#ifdef Q_OS_LINUX
+    if (QGuiApplication::platformName() == QStringLiteral("xcb")) {
+        std::unique_ptr<XShmCaptureBackend> shm(new XShmCaptureBackend(screen));
+        QImage probe(size, QImage::Format_RGB32);
+
+        if (shm->init(size) && shm->grab(r, probe, probe.rect())) {
+            return shm;
+        }
+    }
+#else
+    Q_UNUSED(r)
+    Q_UNUSED(size)
+#endif
+
+    return std::unique_ptr<CaptureBackend>(new QtCaptureBackend(screen));
+}
+
+//
+// QtCaptureBackend
+//
+
+QtCaptureBackend::QtCaptureBackend(QScreen *screen)
+    : m_screen(screen)
+{
+}
+
+bool QtCaptureBackend::grab(const QRect &r,
+                            QImage &img,
+                            const QRect &part)
+{
+    // Qt grabs in logical pixels relative to the screen, so the whole area is grabbed to avoid rounding of the part.
+    const auto origin = m_screen->geometry().topLeft();
+
+    copyImage(m_screen->grabWindow(0, r.x() - origin.x(), r.y() - origin.y(), r.width(), r.height()).toImage(),
+              img,
+              part);
+
+    return true;
+}
@@ -0,0 +1,65 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QImage>
+#include <QRect>
+
+// C++ include.
+#include <memory>
+
+class QScreen;
+
+//! \return Screen with the biggest part of area \a r in global coordinates, the primary one if none.
+QScreen *screenFor(const QRect &r);
+
+//! \return Area \a r in global coordinates of \a screen in device pixels. Qt keeps the origin of
+//! the screen the same in both coordinate systems, only offsets from it are scaled.
+QRect nativeRect(QScreen *screen,
+                 const QRect &r);
+
+//
+// CaptureBackend
+//
+
+//! Source of screen pixels. Should be created and used in one thread.
+class CaptureBackend
+{
+public:
+    virtual ~CaptureBackend() = default;
+
+    //! Grab \a part of area \a r in global coordinates into the same place of the preallocated
+    //! \a img. \a part is in pixels of \a img. \return false if grabbing failed and another
+    //! backend should be used.
+    virtual bool grab(const QRect &r,
+                      QImage &img,
+                      const QRect &part) = 0;
+
+    //! \return The fastest backend available for area \a r of \a screen, frames are of \a size.
+    static std::unique_ptr<CaptureBackend> create(QScreen *screen,
+                                                  const QRect &r,
+                                                  const QSize &size);
+}; // class CaptureBackend
+
+//
+// QtCaptureBackend
+//
+
+//! Backend on QScreen::grabWindow(). Works everywhere.
+class QtCaptureBackend final : public CaptureBackend
+{
+public:
+    explicit QtCaptureBackend(QScreen *screen);
+
+    bool grab(const QRect &r,
+              QImage &img,
+              const QRect &part) override;
+
+private:
+    //! Screen.
+    QScreen *m_screen;
+}; // class QtCaptureBackend
@@ -0,0 +1,321 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF recorder include.
+#include "cursor_tracker.hpp"
+
+// Qt include.
+#include <QColor>
+#include <QHash>
+
+#ifdef Q_OS_LINUX
+#include <X11/Xlib.h>
+#include <X11/extensions/Xfixes.h>
+#endif
+
+#ifdef Q_OS_WINDOWS
+#include <Windows.h>
+#endif
+
+#ifdef Q_OS_LINUX
+//! Maximum count of cached cursor sprites.
+static const qsizetype s_maxSprites = 32;
+#endif
+
+//
+// CursorTrackerPrivate
+//
+
+struct CursorTrackerPrivate {
+#ifdef Q_OS_LINUX
+    CursorTrackerPrivate()
+    {
+        m_display = XOpenDisplay(nullptr);
+
+        if (m_display) {
+            m_root = DefaultRootWindow(m_display);
+
+            int errorBase = 0;
+
+            if (XFixesQueryExtension(m_display, &m_eventBase, &errorBase)) {
+                m_hasFixes = true;
+
+                XFixesSelectCursorInput(m_display, m_root, XFixesDisplayCursorNotifyMask);
+            }
+        }
+    }
+
+    ~CursorTrackerPrivate()
+    {
+        if (m_display) {
+            if (m_hasFixes) {
+                XFixesSelectCursorInput(m_display, m_root, 0);
+            }
+
+            XCloseDisplay(m_display);
+        }
+    }
+
+    //! Sprite of the cursor.
+    struct Sprite {
+        //! Image.
+        QImage m_image;
+        //! Hot spot in the image.
+        QPoint m_hotSpot;
+    }; // struct Sprite
+
+    //! Read cursor notifications that are already received.
+    void processEvents();
+    //! Read current sprite from the server and cache it.
+    void fetchSprite();
+
+    //! Display.
+    Display *m_display = nullptr;
+    //! Root window.
+    Window m_root = 0;
+    //! Base of XFixes events.
+    int m_eventBase = 0;
+    //! Is XFixes available.
+    bool m_hasFixes = false;
+    //! Current sprite should be read from the server.
+    bool m_dirty = true;
+    //! Serial of the current sprite.
+    unsigned long m_serial = 0;
+    //! Converted sprites.
+    QHash<unsigned long, Sprite> m_sprites;
+#endif // Q_OS_LINUX
+}; // struct CursorTrackerPrivate
+
+#ifdef Q_OS_LINUX
+
+void CursorTrackerPrivate::processEvents()
+{
+    while (XEventsQueued(m_display, QueuedAlready) > 0) {
+        XEvent e;
+        XNextEvent(m_display, &e);
+
+        if (e.type == m_eventBase + XFixesCursorNotify) {
+            const auto n = reinterpret_cast<XFixesCursorNotifyEvent *>(&e);
+
+            if (m_sprites.contains(n->cursor_serial)) {
+                m_serial = n->cursor_serial;
+            } else {
+                m_dirty = true;
+            }
+        }
+    }
+}
+
+void CursorTrackerPrivate::fetchSprite()
+{
+    m_dirty = false;
+
+    XFixesCursorImage *cursor = XFixesGetCursorImage(m_display);
+
+    if (!cursor) {
+        return;
+    }
+
+    m_serial = cursor->cursor_serial;
+
+    if (!m_sprites.contains(m_serial)) {
+        if (m_sprites.size() >= s_maxSprites) {
+            m_sprites.clear();
+        }
+
+        Sprite s;
+        s.m_image = QImage(cursor->width, cursor->height, QImage::Format_ARGB32_Premultiplied);
+        s.m_hotSpot = QPoint(cursor->xhot, cursor->yhot);
+
+        // XFixes gives pixels as unsigned long, that is 64 bits wide on 64-bit Linux.
+        for (int y = 0; y < cursor->height; ++y) {
+            auto line = reinterpret_cast<quint32 *>(s.m_image.scanLine(y));
+            const auto src = cursor->pixels + static_cast<size_t>(y) * cursor->width;
+
+            for (int x = 0; x < cursor->width; ++x) {
+                line[x] = static_cast<quint32>(src[x]);
+            }
+        }
+
+        m_sprites.insert(m_serial, s);
+    }
+
+    XFree(cursor);
+}
+
+#endif // Q_OS_LINUX
+
+//
+// CursorTracker
+//
+
+CursorTracker::CursorTracker()
+    : m_d(new CursorTrackerPrivate)
+{
+}
+
+CursorTracker::~CursorTracker()
+{
+}
+
+MouseCursor CursorTracker::cursor(const QRect &r,
+                                  const QImage &i)
+{
+    MouseCursor ret;
+
+#ifdef Q_OS_LINUX
+    Q_UNUSED(i)
+
+    if (!m_d->m_display || !m_d->m_hasFixes) {
+        return ret;
+    }
+
+    Window root = 0;
+    Window child = 0;
+    int rootX = 0;
+    int rootY = 0;
+    int winX = 0;
+    int winY = 0;
+    unsigned int mask = 0;
+
+    // The only round trip per frame. Notifications about cursor changes
+    // are read together with the reply.
+    if (!XQueryPointer(m_d->m_display, m_d->m_root, &root, &child, &rootX, &rootY, &winX, &winY, &mask)) {
+        return ret;
+    }
+
+    m_d->processEvents();
+
+    if (m_d->m_dirty) {
+        m_d->fetchSprite();
+    }
+
+    const auto it = m_d->m_sprites.constFind(m_d->m_serial);
+
+    ret.m_hotSpot = QPoint(rootX - r.x(), rootY - r.y());
+
+    if (it != m_d->m_sprites.cend()) {
+        const QRect spriteRect(QPoint(rootX, rootY) - it->m_hotSpot, it->m_image.size());
+
+        ret.m_serial = m_d->m_serial;
+
+        if (r.intersects(spriteRect)) {
+            ret.m_image = it->m_image;
+            ret.m_rect = spriteRect.translated(-r.topLeft());
+        }
+    }
+
+#elif defined(Q_OS_WINDOWS)
+    CURSORINFO cursor = {sizeof(cursor)};
+
+    if (GetCursorInfo(&cursor) && cursor.flags == CURSOR_SHOWING) {
+        ICONINFO info = {sizeof(info)};
+
+        if (GetIconInfo(cursor.hCursor, &info)) {
+            HWND hWnd = GetDesktopWindow();
+            HDC hDC = GetWindowDC(hWnd);
+            HDC hdcMem = CreateCompatibleDC(hDC);
+            BITMAP bmpCursor = {0};
+            GetObject(info.hbmColor ? info.hbmColor : info.hbmMask, sizeof(bmpCursor), &bmpCursor);
+            HBITMAP hBitmap = CreateCompatibleBitmap(hDC, bmpCursor.bmWidth, bmpCursor.bmHeight);
+            auto original = SelectObject(hdcMem, hBitmap);
+
+            const QPoint ctl(cursor.ptScreenPos.x - info.xHotspot, cursor.ptScreenPos.y - info.yHotspot);
+            int w = bmpCursor.bmWidth;
+            int h = bmpCursor.bmHeight;
+
+            for (int x = 0; x < w; ++x) {
+                for (int y = 0; y < h; ++y) {
+                    const QPoint c = QPoint(x, y) + ctl;
+
+                    if (r.contains(c)) {
+                        const auto color = i.pixelColor(c - r.topLeft());
+                        SetPixel(hdcMem, x, y, RGB(color.red(), color.green(), color.blue()));
+                    }
+                }
+            }
+
+            DrawIconEx(hdcMem, 0, 0, cursor.hCursor, 0, 0, 0, nullptr, DI_DEFAULTSIZE | DI_NORMAL);
+
+            QImage img(bmpCursor.bmWidth, bmpCursor.bmHeight, QImage::Format_ARGB32);
+            img.fill(Qt::transparent);
+
+            for (int x = 0; x < w; ++x) {
+                for (int y = 0; y < h; ++y) {
+                    const QPoint c = QPoint(x, y) + ctl;
+
+                    if (r.contains(c)) {
+                        const auto winColor = GetPixel(hdcMem, x, y);
+                        const auto color1 = i.pixelColor(c - r.topLeft());
+                        const auto color2 = QColor(GetRValue(winColor), GetGValue(winColor), GetBValue(winColor));
+
+                        if (color1 != color2) {
+                            img.setPixelColor(x, y, color2);
+                        }
+                    }
+                }
+            }
+
+            ret.m_hotSpot = QPoint(cursor.ptScreenPos.x - r.x(), cursor.ptScreenPos.y - r.y());
+
+            if (r.intersects({ctl, QSize(w, h)})) {
+                ret.m_rect = QRect(ctl - r.topLeft(), QSize(w, h));
+                ret.m_image = img;
+            }
+
+            if (info.hbmMask) {
+                DeleteObject(info.hbmMask);
+            }
+
+            if (info.hbmColor) {
+                DeleteObject(info.hbmColor);
+            }
+
+            SelectObject(hdcMem, original);
+
+            DeleteDC(hdcMem);
+            DeleteObject(hBitmap);
+        }
+
+        if (cursor.hCursor) {
+            DeleteObject(cursor.hCursor);
+        }
+    }
+#else
+    Q_UNUSED(r)
+    Q_UNUSED(i)
+#endif
+
+    return ret;
+}
+
+QPoint CursorTracker::position()
+{
+#ifdef Q_OS_LINUX
+    if (!m_d->m_display) {
+        return {};
+    }
+
+    Window root = 0;
+    Window child = 0;
+    int rootX = 0;
+    int rootY = 0;
+    int winX = 0;
+    int winY = 0;
+    unsigned int mask = 0;
+
+    if (XQueryPointer(m_d->m_display, m_d->m_root, &root, &child, &rootX, &rootY, &winX, &winY, &mask)) {
+        return {rootX, rootY};
+    }
+#elif defined(Q_OS_WINDOWS)
+    POINT p;
+
+    if (GetCursorPos(&p)) {
+        return {p.x, p.y};
+    }
+#endif
+
+    return {};
+}
@@ -0,0 +1,54 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QImage>
+#include <QRect>
+#include <QScopedPointer>
+
+//
+// MouseCursor
+//
+
+//! Mouse cursor relative to the grab area.
+struct MouseCursor {
+    //! Sprite of the cursor.
+    QImage m_image;
+    //! Rect of the sprite, empty if cursor is out of the grab area.
+    QRect m_rect;
+    //! Hot spot of the cursor, position of clicks.
+    QPoint m_hotSpot = {-1, -1};
+    //! Serial of the sprite, changes when the cursor image changes. 0 if unknown.
+    unsigned long m_serial = 0;
+}; // struct MouseCursor
+
+//
+// CursorTracker
+//
+
+struct CursorTrackerPrivate;
+
+//! Tracker of the mouse cursor. Should be created and used in one thread.
+//! On X11 it keeps one connection to the display and converts the sprite
+//! only when XFixes notifies about the change of the cursor.
+class CursorTracker final
+{
+public:
+    CursorTracker();
+    ~CursorTracker();
+
+    //! \return Cursor relative to the grab area \a r, \a img is a grabbed image of the area.
+    MouseCursor cursor(const QRect &r,
+                       const QImage &img);
+    //! \return Global position of the cursor, cheaper than cursor().
+    QPoint position();
+
+private:
+    Q_DISABLE_COPY(CursorTracker)
+
+    QScopedPointer<CursorTrackerPrivate> m_d;
+}; // class CursorTracker
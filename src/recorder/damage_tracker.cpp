@@ -0,0 +1,121 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF recorder include.
+#include "damage_tracker.hpp"
+
+#ifdef Q_OS_LINUX
+#include <X11/Xlib.h>
+#include <X11/extensions/Xdamage.h>
+#include <X11/extensions/Xfixes.h>
+#endif
+
+//
+// DamageTrackerPrivate
+//
+
+struct DamageTrackerPrivate {
+    explicit DamageTrackerPrivate(const QRect &r)
+        : m_rect(r)
+    {
+#ifdef Q_OS_LINUX
+        m_display = XOpenDisplay(nullptr);
+
+        if (m_display) {
+            int eventBase = 0;
+            int errorBase = 0;
+
+            if (XDamageQueryExtension(m_display, &eventBase, &errorBase)) {
+                m_damage = XDamageCreate(m_display, DefaultRootWindow(m_display), XDamageReportNonEmpty);
+                m_region = XFixesCreateRegion(m_display, nullptr, 0);
+            }
+        }
+#endif
+    }
+
+    ~DamageTrackerPrivate()
+    {
+#ifdef Q_OS_LINUX
+        if (m_display) {
+            if (m_damage) {
+                XDamageDestroy(m_display, m_damage);
+                XFixesDestroyRegion(m_display, m_region);
+            }
+
+            XCloseDisplay(m_display);
+        }
+#endif
+    }
+
+    //! Tracked area.
+    QRect m_rect;
+#ifdef Q_OS_LINUX
+    //! Is it the first request of damage.
+    bool m_first = true;
+    //! Display.
+    Display *m_display = nullptr;
+    //! Damage object of the root window.
+    Damage m_damage = 0;
+    //! Region that receives damage.
+    XserverRegion m_region = 0;
+#endif
+}; // struct DamageTrackerPrivate
+
+//
+// DamageTracker
+//
+
+DamageTracker::DamageTracker(const QRect &r)
+    : m_d(new DamageTrackerPrivate(r))
+{
+}
+
+DamageTracker::~DamageTracker()
+{
+}
+
+QRect DamageTracker::damage()
+{
+    const QRect whole(QPoint(0, 0), m_d->m_rect.size());
+
+#ifdef Q_OS_LINUX
+    if (!m_d->m_damage) {
+        return whole;
+    }
+
+    // Notifications are not needed, damage is polled once per frame.
+    while (XEventsQueued(m_d->m_display, QueuedAlready) > 0) {
+        XEvent e;
+        XNextEvent(m_d->m_display, &e);
+    }
+
+    // Take accumulated damage and reset it.
+    XDamageSubtract(m_d->m_display, m_d->m_damage, None, m_d->m_region);
+
+    if (m_d->m_first) {
+        m_d->m_first = false;
+
+        return whole;
+    }
+
+    int count = 0;
+    XRectangle bounds;
+    XRectangle *rects = XFixesFetchRegionAndBounds(m_d->m_display, m_d->m_region, &count, &bounds);
+
+    QRect changed;
+
+    for (int i = 0; i < count; ++i) {
+        changed |= QRect(rects[i].x, rects[i].y, rects[i].width, rects[i].height) & m_d->m_rect;
+    }
+
+    if (rects) {
+        XFree(rects);
+    }
+
+    return changed.translated(-m_d->m_rect.topLeft());
+#else
+    return whole;
+#endif
+}
@@ -0,0 +1,35 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QRect>
+#include <QScopedPointer>
+
+//
+// DamageTracker
+//
+
+struct DamageTrackerPrivate;
+
+//! Tracker of changed parts of the screen. Should be created and used in one thread.
+//! On X11 it listens to XDamage, elsewhere the whole area is always reported as changed.
+class DamageTracker final
+{
+public:
+    //! \a r is the tracked area in device pixels of the root window.
+    explicit DamageTracker(const QRect &r);
+    ~DamageTracker();
+
+    //! \return Bounding rect of parts of the area changed since previous call,
+    //! relative to the area. The whole area is returned on the first call.
+    QRect damage();
+
+private:
+    Q_DISABLE_COPY(DamageTracker)
+
+    QScopedPointer<DamageTrackerPrivate> m_d;
+}; // class DamageTracker
@@ -0,0 +1,179 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF recorder include.
+#include "downscale.hpp"
+
+// C++ include.
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace /* anonymous */
+{
+
+//! Reduce two lines \a row0 and \a row1 of 2 * \a count pixels into \a count pixels of \a dst.
+void halveLine(const quint32 *row0,
+               const quint32 *row1,
+               quint32 *dst,
+               int count)
+{
+    int x = 0;
+
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i two = _mm_set1_epi16(2);
+
+    // 8 source pixels of both lines give 4 pixels.
+    for (; x + 4 <= count; x += 4) {
+        __m128i sums[2];
+
+        for (int i = 0; i < 2; ++i) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + x * 2 + i * 4));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + x * 2 + i * 4));
+
+            // Vertical sums of pixels 0, 1 and 2, 3 in 16 bits per channel.
+            const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+            const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+
+            // Horizontal sums of neighbours: 0 + 1 and 2 + 3.
+            const __m128i s = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+            sums[i] = _mm_srli_epi16(_mm_add_epi16(s, two), 2);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), _mm_packus_epi16(sums[0], sums[1]));
+    }
+#elif defined(__ARM_NEON)
+    // 8 source pixels of both lines give 4 pixels, even and odd pixels are loaded apart.
+    for (; x + 4 <= count; x += 4) {
+        const uint32x4x2_t a = vld2q_u32(row0 + x * 2);
+        const uint32x4x2_t b = vld2q_u32(row1 + x * 2);
+
+        const uint8x16_t a0 = vreinterpretq_u8_u32(a.val[0]);
+        const uint8x16_t a1 = vreinterpretq_u8_u32(a.val[1]);
+        const uint8x16_t b0 = vreinterpretq_u8_u32(b.val[0]);
+        const uint8x16_t b1 = vreinterpretq_u8_u32(b.val[1]);
+
+        const uint16x8_t lo = vaddq_u16(vaddl_u8(vget_low_u8(a0), vget_low_u8(a1)),
+                                        vaddl_u8(vget_low_u8(b0), vget_low_u8(b1)));
+        const uint16x8_t hi = vaddq_u16(vaddl_u8(vget_high_u8(a0), vget_high_u8(a1)),
+                                        vaddl_u8(vget_high_u8(b0), vget_high_u8(b1)));
+
+        vst1q_u32(dst + x, vreinterpretq_u32_u8(vcombine_u8(vrshrn_n_u16(lo, 2), vrshrn_n_u16(hi, 2))));
+    }
+#endif
+
+    for (; x < count; ++x) {
+        const quint32 p[4] = {row0[x * 2], row0[x * 2 + 1], row1[x * 2], row1[x * 2 + 1]};
+        quint32 ret = 0;
+
+        for (int c = 0; c < 32; c += 8) {
+            const auto sum =
+                ((p[0] >> c) & 0xff) + ((p[1] >> c) & 0xff) + ((p[2] >> c) & 0xff) + ((p[3] >> c) & 0xff);
+            ret |= ((sum + 2) >> 2) << c;
+        }
+
+        dst[x] = ret;
+    }
+}
+
+//! Reduce \a factor lines starting at \a src with \a stride pixels between them into \a count
+//! pixels of \a dst. \a sums is a scratch of 4 * \a count values.
+void reduceLine(const quint32 *src,
+                qsizetype stride,
+                quint32 *dst,
+                int count,
+                int factor,
+                quint32 *sums)
+{
+    std::memset(sums, 0, sizeof(quint32) * 4 * count);
+
+    // Channels are summed apart without dependencies between pixels, so compilers vectorize it.
+    for (int y = 0; y < factor; ++y) {
+        const auto line = src + stride * y;
+
+        for (int x = 0; x < count; ++x) {
+            for (int i = 0; i < factor; ++i) {
+                const auto p = line[x * factor + i];
+
+                sums[x * 4] += p & 0xff;
+                sums[x * 4 + 1] += (p >> 8) & 0xff;
+                sums[x * 4 + 2] += (p >> 16) & 0xff;
+                sums[x * 4 + 3] += p >> 24;
+            }
+        }
+    }
+
+    const quint32 area = factor * factor;
+    const quint32 half = area / 2;
+
+    for (int x = 0; x < count; ++x) {
+        dst[x] = ((sums[x * 4] + half) / area) | (((sums[x * 4 + 1] + half) / area) << 8)
+            | (((sums[x * 4 + 2] + half) / area) << 16) | (((sums[x * 4 + 3] + half) / area) << 24);
+    }
+}
+
+} /* namespace anonymous */
+
+QRect downscaledRect(const QRect &r,
+                     int factor)
+{
+    if (r.isEmpty() || factor <= 1) {
+        return r;
+    }
+
+    return QRect(QPoint(r.left() / factor, r.top() / factor), QPoint(r.right() / factor, r.bottom() / factor));
+}
+
+void downscale(const QImage &src,
+               QImage &dst,
+               const QRect &r,
+               int factor)
+{
+    const auto rect = r & dst.rect() & QRect(0, 0, src.width() / factor, src.height() / factor);
+
+    if (rect.isEmpty()) {
+        return;
+    }
+
+    const auto stride = static_cast<qsizetype>(src.bytesPerLine() / 4);
+
+    if (factor <= 1) {
+        const auto bytes = static_cast<size_t>(rect.width()) * 4;
+
+        for (int y = rect.top(); y <= rect.bottom(); ++y) {
+            std::memcpy(reinterpret_cast<quint32 *>(dst.scanLine(y)) + rect.x(),
+                        reinterpret_cast<const quint32 *>(src.constScanLine(y)) + rect.x(),
+                        bytes);
+        }
+
+        return;
+    }
+
+    std::vector<quint32> sums;
+
+    if (factor > 2) {
+        sums.resize(static_cast<size_t>(rect.width()) * 4);
+    }
+
+    for (int y = rect.top(); y <= rect.bottom(); ++y) {
+        const auto from = reinterpret_cast<const quint32 *>(src.constScanLine(y * factor)) + rect.x() * factor;
+        const auto to = reinterpret_cast<quint32 *>(dst.scanLine(y)) + rect.x();
+
+        // Halving is the usual case of HiDPI screens.
+        if (factor == 2) {
+            halveLine(from, from + stride, to, rect.width());
+        } else {
+            reduceLine(from, stride, to, rect.width(), factor, sums.data());
+        }
+    }
+}
@@ -0,0 +1,21 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QImage>
+#include <QRect>
+
+//! \return Area of \a r of the image reduced \a factor times, the area covers every touched pixel.
+QRect downscaledRect(const QRect &r,
+                     int factor);
+
+//! Fill \a r of 32 bits per pixel \a dst with the area of \a src that is \a factor times bigger,
+//! every pixel is the average of its factor x factor box. The box of \a r should be inside \a src.
+void downscale(const QImage &src,
+               QImage &dst,
+               const QRect &r,
+               int factor);
@@ -19,6 +19,9 @@
 #include <Windows.h>
 #endif // Q_OS_WINDOWS
 
+// Qt include.
+#include <QSet>
+
 //
 // EventMonitorPrivate
 //
@@ -29,7 +32,20 @@ struct EventMonitorPrivate {
     {
     }
 
+    //! Push button event.
+    void pushButton(InputEvent::Type type,
+                    quint8 button);
+    //! Push key event, \a name is called only for the key that wasn't met before.
+    template<class Name>
+    void pushKey(InputEvent::Type type,
+                 quint32 key,
+                 Name name);
+
     EventMonitor *m_q;
+    //! Queue of events.
+    InputEvents m_events;
+    //! Keys with known names, touched by the monitor thread only.
+    QSet<quint32> m_interned;
 
 #ifdef Q_OS_LINUX
     Display *m_display = nullptr;
@@ -44,6 +60,35 @@ struct EventMonitorPrivate {
 #endif
 }; // struct EventMonitorPrivate
 
+void EventMonitorPrivate::pushButton(InputEvent::Type type,
+                                     quint8 button)
+{
+    InputEvent e;
+    e.m_timestamp = monotonicNow();
+    e.m_type = type;
+    e.m_button = button;
+
+    m_events.push(e);
+}
+
+template<class Name>
+void EventMonitorPrivate::pushKey(InputEvent::Type type,
+                                  quint32 key,
+                                  Name name)
+{
+    InputEvent e;
+    e.m_timestamp = monotonicNow();
+    e.m_type = type;
+    e.m_key = key;
+
+    if (!m_interned.contains(key)) {
+        m_events.setKeyName(key, name().toUpper());
+        m_interned.insert(key);
+    }
+
+    m_events.push(e);
+}
+
 #ifdef Q_OS_LINUX
 
 void EventMonitorPrivate::callback(XPointer ptr,
@@ -60,28 +105,26 @@ void EventMonitorPrivate::handleRecordEvent(XRecordInterceptData *data)
         switch (event->u.u.type) {
         case ButtonPress: {
             if (filterWheelEvent(event->u.u.detail)) {
-                emit m_q->buttonPress();
+                pushButton(InputEvent::ButtonPress, event->u.u.detail);
             }
         } break;
 
         case ButtonRelease: {
             if (filterWheelEvent(event->u.u.detail)) {
-                emit m_q->buttonRelease();
+                pushButton(InputEvent::ButtonRelease, event->u.u.detail);
             }
         } break;
 
-        case KeyPress: {
-            const KeyCode keycode = event->u.u.detail;
-            KeySym sym = XkbKeycodeToKeysym(m_display_datalink, keycode, 0, 0);
-
-            emit m_q->keyPressed(QString(XKeysymToString(sym)));
-        } break;
-
+        case KeyPress:
         case KeyRelease: {
             const KeyCode keycode = event->u.u.detail;
-            KeySym sym = XkbKeycodeToKeysym(m_display_datalink, keycode, 0, 0);
+            const KeySym sym = XkbKeycodeToKeysym(m_display_datalink, keycode, 0, 0);
 
-            emit m_q->keyReleased(QString(XKeysymToString(sym)));
+            pushKey(event->u.u.type == KeyPress ? InputEvent::KeyPress : InputEvent::KeyRelease,
+                    static_cast<quint32>(sym),
+                    [sym]() {
+                        return QString::fromLatin1(XKeysymToString(sym));
+                    });
         } break;
 
         default:
@@ -104,7 +147,7 @@ bool EventMonitorPrivate::filterWheelEvent(int detail)
 #define WM_QUIT_LOOP (WM_USER + 1)
 
 HHOOK s_hKeyHook = NULL;
-EventMonitor *s_eventMonitor = nullptr;
+EventMonitorPrivate *s_eventMonitor = nullptr;
 HHOOK s_hMouseHook = NULL;
 DWORD s_threadId = 0;
 
@@ -114,16 +157,28 @@ LRESULT CALLBACK MouseHookProc(int nCode,
 {
     if (nCode >= 0) {
         switch (wParam) {
-        case WM_LBUTTONDOWN:
-        case WM_RBUTTONDOWN:
+        case WM_LBUTTONDOWN: {
+            s_eventMonitor->pushButton(InputEvent::ButtonPress, 1);
+        } break;
+
         case WM_MBUTTONDOWN: {
-            emit s_eventMonitor->buttonPress();
+            s_eventMonitor->pushButton(InputEvent::ButtonPress, 2);
+        } break;
+
+        case WM_RBUTTONDOWN: {
+            s_eventMonitor->pushButton(InputEvent::ButtonPress, 3);
+        } break;
+
+        case WM_LBUTTONUP: {
+            s_eventMonitor->pushButton(InputEvent::ButtonRelease, 1);
         } break;
 
-        case WM_LBUTTONUP:
-        case WM_RBUTTONUP:
         case WM_MBUTTONUP: {
-            emit s_eventMonitor->buttonRelease();
+            s_eventMonitor->pushButton(InputEvent::ButtonRelease, 2);
+        } break;
+
+        case WM_RBUTTONUP: {
+            s_eventMonitor->pushButton(InputEvent::ButtonRelease, 3);
         } break;
 
         default: {
@@ -135,9 +190,8 @@ LRESULT CALLBACK MouseHookProc(int nCode,
     return CallNextHookEx(s_hMouseHook, nCode, wParam, lParam);
 }
 
-template<class Func>
 void handleKey(LPARAM lParam,
-               Func f)
+               InputEvent::Type type)
 {
     KBDLLHOOKSTRUCT *kbStruct = (KBDLLHOOKSTRUCT *)lParam;
     if (s_eventMonitor) {
@@ -147,10 +201,15 @@ void handleKey(LPARAM lParam,
             lKeyParam |= (1 << 24);
         }
 
-        wchar_t keyName[64];
-        if (GetKeyNameTextW(lKeyParam, keyName, 64) > 0) {
-            f(QString::fromWCharArray(&keyName[0]));
-        }
+        s_eventMonitor->pushKey(type, static_cast<quint32>(lKeyParam), [lKeyParam]() {
+            wchar_t keyName[64];
+
+            if (GetKeyNameTextW(lKeyParam, keyName, 64) > 0) {
+                return QString::fromWCharArray(&keyName[0]);
+            }
+
+            return QString();
+        });
     }
 }
 
@@ -161,15 +220,11 @@ LRESULT CALLBACK KeyboardHookProc(int nCode,
     if (nCode == HC_ACTION) {
         switch (wParam) {
         case WM_KEYDOWN: {
-            handleKey(lParam, [](const QString &keyName) {
-                emit s_eventMonitor->keyPressed(keyName);
-            });
+            handleKey(lParam, InputEvent::KeyPress);
         } break;
 
         case WM_KEYUP: {
-            handleKey(lParam, [](const QString &keyName) {
-                emit s_eventMonitor->keyReleased(keyName);
-            });
+            handleKey(lParam, InputEvent::KeyRelease);
         } break;
 
         default: {
@@ -202,6 +257,11 @@ EventMonitor::~EventMonitor()
 #endif // Q_OS_LINUX
 }
 
+InputEvents *EventMonitor::events() const
+{
+    return &m_d->m_events;
+}
+
 void EventMonitor::stopListening()
 {
 #ifdef Q_OS_LINUX
@@ -269,7 +329,7 @@ void EventMonitor::run()
         HHOOK m_hook;
     };
 
-    s_eventMonitor = this;
+    s_eventMonitor = m_d.data();
     s_threadId = GetCurrentThreadId();
     HINSTANCE hInstance = GetModuleHandle(NULL);
     s_hKeyHook = SetWindowsHookEx(WH_KEYBOARD_LL, KeyboardHookProc, hInstance, 0);
@@ -9,29 +9,30 @@
 #include <QScopedPointer>
 #include <QThread>
 
+// GIF recorder include.
+#include "input_events.hpp"
+
 //
 // EventMonitor
 //
 
 struct EventMonitorPrivate;
 
-//! Mosue events monitor.
+//! Mouse and keyboard events monitor. Events are pushed into the queue
+//! without allocations, capture drains it once per frame.
 class EventMonitor final : public QThread
 {
     Q_OBJECT
 
-signals:
-    void buttonPress();
-    void buttonRelease();
-    void keyPressed(const QString &);
-    void keyReleased(const QString &);
-
 public:
     EventMonitor();
     ~EventMonitor() override;
 
     void stopListening();
 
+    //! \return Queue of events.
+    InputEvents *events() const;
+
 protected:
     void run() override;
 
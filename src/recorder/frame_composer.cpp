@@ -0,0 +1,121 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF recorder include.
+#include "frame_composer.hpp"
+#include "frame_source.hpp"
+#include "overlay_compositor.hpp"
+
+// Qt include.
+#include <QtConcurrent>
+
+//
+// FrameComposer
+//
+
+FrameComposer::FrameComposer(const FrameSource &frames,
+                             const OverlayTrack &track)
+    : m_frames(frames)
+    , m_track(track)
+{
+}
+
+FrameComposer::~FrameComposer()
+{
+    reset();
+}
+
+OverlayOptions FrameComposer::options() const
+{
+    return m_options;
+}
+
+void FrameComposer::setOptions(const OverlayOptions &o)
+{
+    reset();
+
+    m_options = o;
+}
+
+qsizetype FrameComposer::count() const
+{
+    return m_frames.count();
+}
+
+QRect FrameComposer::rect(qsizetype idx) const
+{
+    return m_frames.rect(idx);
+}
+
+QSize FrameComposer::size(qsizetype idx) const
+{
+    return m_frames.size(idx);
+}
+
+QImage FrameComposer::compose(qsizetype idx) const
+{
+    auto img = m_frames.at(idx);
+
+    if (img.isNull()) {
+        return img;
+    }
+
+    const auto s = m_track.at(idx);
+
+    // Every thread keeps its own sprites.
+    thread_local OverlayCompositor compositor;
+
+    MouseCursor cursor;
+    cursor.m_rect = s.m_cursorRect;
+    cursor.m_hotSpot = s.m_hotSpot;
+    cursor.m_serial = s.m_cursor;
+
+    if (m_options.m_cursor && s.m_cursor) {
+        cursor.m_image = m_track.cursor(s.m_cursor);
+    }
+
+    const auto o = compositor.layout(cursor,
+                                     m_options.m_clicks && s.m_click,
+                                     (m_options.m_keys && s.m_key ? m_track.keyName(s.m_key) : QString()),
+                                     m_track.frameSize());
+
+    compositor.draw(img, o, m_frames.rect(idx).topLeft());
+
+    return img;
+}
+
+QImage FrameComposer::take(qsizetype idx,
+                           qsizetype available)
+{
+    if (idx != m_first) {
+        reset();
+        m_first = idx;
+    }
+
+    const auto ahead = static_cast<qsizetype>(qMax(1, m_pool.maxThreadCount()) * 2);
+    const auto limit = qMax(idx + 1, qMin(available, idx + ahead));
+
+    for (auto i = m_first + static_cast<qsizetype>(m_ahead.size()); i < limit; ++i) {
+        m_ahead.push_back(QtConcurrent::run(&m_pool, [this, i]() {
+            return compose(i);
+        }));
+    }
+
+    auto img = m_ahead.front().result();
+    m_ahead.pop_front();
+    ++m_first;
+
+    return img;
+}
+
+void FrameComposer::reset()
+{
+    for (auto &f : m_ahead) {
+        f.waitForFinished();
+    }
+
+    m_ahead.clear();
+    m_first = 0;
+}
@@ -0,0 +1,70 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QFuture>
+#include <QImage>
+#include <QThreadPool>
+
+// C++ include.
+#include <deque>
+
+// GIF recorder include.
+#include "overlay_track.hpp"
+
+class FrameSource;
+
+//
+// FrameComposer
+//
+
+//! Composer of clean recorded frames with overlays of the track. Frames don't
+//! depend on each other, so they are composed ahead in the pool of threads.
+class FrameComposer final
+{
+public:
+    FrameComposer(const FrameSource &frames,
+                  const OverlayTrack &track);
+    ~FrameComposer();
+
+    //! \return Options of overlays.
+    OverlayOptions options() const;
+    //! Set options of overlays. Drops frames composed ahead.
+    void setOptions(const OverlayOptions &o);
+
+    //! \return Count of frames.
+    qsizetype count() const;
+    //! \return Place of frame at the given index on the screen.
+    QRect rect(qsizetype idx) const;
+    //! \return Size of frame at the given index.
+    QSize size(qsizetype idx) const;
+
+    //! \return Frame at the given index with overlays. Thread-safe.
+    QImage compose(qsizetype idx) const;
+    //! \return Frame at the given index with overlays, frames after it and before \a available
+    //! are composed ahead. Should be called for consecutive indices from one thread.
+    QImage take(qsizetype idx,
+                qsizetype available);
+    //! Drop frames composed ahead.
+    void reset();
+
+private:
+    Q_DISABLE_COPY(FrameComposer)
+
+    //! Frames.
+    const FrameSource &m_frames;
+    //! Overlays.
+    const OverlayTrack &m_track;
+    //! Options.
+    OverlayOptions m_options;
+    //! Pool.
+    QThreadPool m_pool;
+    //! Frames composed ahead.
+    std::deque<QFuture<QImage>> m_ahead;
+    //! Index of the first frame composed ahead.
+    qsizetype m_first = 0;
+}; // class FrameComposer
@@ -0,0 +1,77 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF recorder include.
+#include "frame_hash.hpp"
+
+// C++ include.
+#include <cstring>
+
+//! Count of independent lanes of the hash. Lanes have no dependencies between
+//! each other, so compilers turn the inner loop into vector multiplications.
+static const int s_lanes = 8;
+//! FNV prime.
+static const quint32 s_prime = 0x01000193u;
+//! FNV offset basis.
+static const quint32 s_basis = 0x811C9DC5u;
+
+quint64 frameHash(const QImage &img,
+                  const QRect &r)
+{
+    const auto rect = r & img.rect();
+
+    quint32 lanes[s_lanes];
+
+    for (int l = 0; l < s_lanes; ++l) {
+        lanes[l] = s_basis + static_cast<quint32>(l);
+    }
+
+    for (int y = rect.top(); y <= rect.bottom(); ++y) {
+        const auto line = reinterpret_cast<const quint32 *>(img.constScanLine(y)) + rect.x();
+        int x = 0;
+
+        for (; x + s_lanes <= rect.width(); x += s_lanes) {
+            for (int l = 0; l < s_lanes; ++l) {
+                lanes[l] = (lanes[l] ^ line[x + l]) * s_prime;
+            }
+        }
+
+        for (int l = 0; x < rect.width(); ++x, ++l) {
+            lanes[l] = (lanes[l] ^ line[x]) * s_prime;
+        }
+    }
+
+    quint64 h = (static_cast<quint64>(rect.width()) << 32) | static_cast<quint32>(rect.height());
+
+    for (int l = 0; l < s_lanes; ++l) {
+        h = (h ^ lanes[l]) * 0x100000001B3ULL;
+    }
+
+    return h;
+}
+
+bool samePixels(const QImage &a,
+                const QImage &b,
+                const QRect &r)
+{
+    const auto rect = r & a.rect() & b.rect();
+
+    if (rect != r) {
+        return false;
+    }
+
+    const auto bytes = static_cast<size_t>(rect.width()) * 4;
+
+    for (int y = rect.top(); y <= rect.bottom(); ++y) {
+        if (std::memcmp(reinterpret_cast<const quint32 *>(a.constScanLine(y)) + rect.x(),
+                        reinterpret_cast<const quint32 *>(b.constScanLine(y)) + rect.x(),
+                        bytes)
+            != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,20 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QImage>
+#include <QRect>
+
+//! \return Fingerprint of pixels in \a r of the 32 bits per pixel \a img.
+//! Equal fingerprints don't guarantee equal pixels, use samePixels() to verify.
+quint64 frameHash(const QImage &img,
+                  const QRect &r);
+
+//! \return Are pixels in \a r of 32 bits per pixel \a a and \a b equal.
+bool samePixels(const QImage &a,
+                const QImage &b,
+                const QRect &r);
@@ -0,0 +1,76 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF recorder include.
+#include "frame_ring.hpp"
+
+//
+// FrameRing
+//
+
+FrameRing::FrameRing(qsizetype capacity,
+                     const QSize &size,
+                     QImage::Format format)
+    : m_slots(static_cast<size_t>(capacity))
+    , m_free(static_cast<int>(capacity))
+    , m_used(0)
+{
+    for (auto &slot : m_slots) {
+        slot.m_image = QImage(size, format);
+        slot.m_image.fill(Qt::black);
+    }
+}
+
+qsizetype FrameRing::capacity() const
+{
+    return static_cast<qsizetype>(m_slots.size());
+}
+
+QSize FrameRing::frameSize() const
+{
+    return m_slots.front().m_image.size();
+}
+
+qsizetype FrameRing::size() const
+{
+    return m_used.available();
+}
+
+bool FrameRing::isEmpty() const
+{
+    return (m_used.available() == 0);
+}
+
+FrameSlot *FrameRing::beginWrite()
+{
+    if (!m_free.tryAcquire()) {
+        return nullptr;
+    }
+
+    return &m_slots[static_cast<size_t>(m_head % capacity())];
+}
+
+void FrameRing::endWrite()
+{
+    ++m_head;
+
+    m_used.release();
+}
+
+FrameSlot *FrameRing::beginRead(int timeout)
+{
+    if (!m_used.tryAcquire(1, timeout)) {
+        return nullptr;
+    }
+
+    return &m_slots[static_cast<size_t>(m_tail % capacity())];
+}
+
+void FrameRing::endRead()
+{
+    ++m_tail;
+
+    m_free.release();
+}
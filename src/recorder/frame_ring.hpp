@@ -0,0 +1,79 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QImage>
+#include <QSemaphore>
+
+// GIF recorder include.
+#include "overlay_track.hpp"
+
+// C++ include.
+#include <vector>
+
+//
+// FrameSlot
+//
+
+//! Slot of the frames ring.
+struct FrameSlot {
+    //! Frame without overlays.
+    QImage m_image;
+    //! Changed part of the frame, only it is valid in the image.
+    QRect m_rect;
+    //! Time of the grab in milliseconds since start of recording.
+    qint64 m_timestamp = 0;
+    //! Overlays of the frame.
+    OverlaySample m_overlay;
+}; // struct FrameSlot
+
+//
+// FrameRing
+//
+
+//! Fixed-capacity ring of preallocated frames for one producer and one consumer.
+class FrameRing final
+{
+public:
+    FrameRing(qsizetype capacity,
+              const QSize &size,
+              QImage::Format format);
+    ~FrameRing() = default;
+
+    //! \return Capacity of the ring.
+    qsizetype capacity() const;
+    //! \return Size of frames.
+    QSize frameSize() const;
+    //! \return Count of frames waiting for the consumer.
+    qsizetype size() const;
+    //! \return Is there no frames for the consumer.
+    bool isEmpty() const;
+
+    //! \return Slot to write to, or nullptr if the ring is full. Never blocks.
+    FrameSlot *beginWrite();
+    //! Publish slot returned by beginWrite().
+    void endWrite();
+
+    //! \return Slot to read from, or nullptr if nothing was published during \a timeout milliseconds.
+    FrameSlot *beginRead(int timeout);
+    //! Return slot returned by beginRead() back to the producer.
+    void endRead();
+
+private:
+    Q_DISABLE_COPY(FrameRing)
+
+    //! Slots.
+    std::vector<FrameSlot> m_slots;
+    //! Free slots.
+    QSemaphore m_free;
+    //! Published slots.
+    QSemaphore m_used;
+    //! Write position, touched by producer only.
+    qsizetype m_head = 0;
+    //! Read position, touched by consumer only.
+    qsizetype m_tail = 0;
+}; // class FrameRing
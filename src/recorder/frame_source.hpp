@@ -0,0 +1,31 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QImage>
+#include <QRect>
+
+//
+// FrameSource
+//
+
+//! Recorded frames. The first frame is whole, the following ones may be only
+//! the changed parts of the screen drawn over the previous ones.
+class FrameSource
+{
+public:
+    virtual ~FrameSource() = default;
+
+    //! \return Count of frames.
+    virtual qsizetype count() const = 0;
+    //! \return Frame at the given index.
+    virtual QImage at(qsizetype idx) const = 0;
+    //! \return Size of frame at the given index.
+    virtual QSize size(qsizetype idx) const = 0;
+    //! \return Place of frame at the given index on the screen.
+    virtual QRect rect(qsizetype idx) const = 0;
+}; // class FrameSource
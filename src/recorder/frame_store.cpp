@@ -0,0 +1,243 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF recorder include.
+#include "frame_store.hpp"
+
+// shared include.
+#include "qoi.hpp"
+
+// Qt include.
+#include <QDir>
+#include <QMutexLocker>
+#include <QThread>
+
+//! How long reader waits for compression of the frame before checking again, in milliseconds.
+static const int s_packWait = 10;
+
+//
+// FrameStore
+//
+
+FrameStore::FrameStore(qint64 memoryBudget)
+    : m_spill(QDir::tempPath() + QDir::separator() + QStringLiteral("gif-recorder-XXXXXX.pack"))
+    , m_memoryBudget(memoryBudget)
+{
+    // Grab and write threads have their own cores.
+    m_pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 2));
+}
+
+FrameStore::~FrameStore()
+{
+    m_pool.waitForDone();
+}
+
+qint64 FrameStore::memoryBudget() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return m_memoryBudget;
+}
+
+void FrameStore::setMemoryBudget(qint64 bytes)
+{
+    QMutexLocker lock(&m_mutex);
+
+    m_memoryBudget = bytes;
+}
+
+bool FrameStore::openSpill() const
+{
+    if (m_spill.isOpen()) {
+        return true;
+    }
+
+    return m_spill.open();
+}
+
+bool FrameStore::append(const QImage &img,
+                        const QRect &rect)
+{
+    QMutexLocker lock(&m_mutex);
+
+    Entry e;
+    e.m_rect = (rect.isNull() ? img.rect() : rect & img.rect());
+    e.m_format = img.format();
+
+    if (e.m_rect.isEmpty()) {
+        return false;
+    }
+
+    const auto lineBytes = static_cast<qint64>(e.m_rect.width()) * img.depth() / 8;
+    e.m_bytes = lineBytes * e.m_rect.height();
+
+    if (m_memoryUsage + e.m_bytes <= m_memoryBudget) {
+        e.m_image = img.copy(e.m_rect);
+
+        if (e.m_image.isNull()) {
+            return false;
+        }
+
+        m_memoryUsage += e.m_bytes;
+        m_entries.push_back(e);
+    } else {
+        QImage part = img.copy(e.m_rect);
+
+        if (part.depth() != 32) {
+            part.convertTo(QImage::Format_RGB32);
+        }
+
+        if (part.isNull()) {
+            return false;
+        }
+
+        e.m_format = part.format();
+        e.m_offset = s_packing;
+
+        const auto idx = m_entries.size();
+        m_entries.push_back(e);
+        ++m_backlog;
+
+        m_pool.start([this, idx, part]() {
+            m_packed.push({idx, qoiEncode(part)});
+            // Done at once, not when written: without the encoder nobody drains frames while capture waits.
+            --m_backlog;
+            m_compressed.release();
+        });
+    }
+
+    // Writing of compressed frames goes with appending, so the file is written from one thread.
+    drain();
+
+    return true;
+}
+
+void FrameStore::drain() const
+{
+    Packed p;
+
+    while (m_packed.pop(p)) {
+        auto &e = m_entries[p.m_index];
+
+        if (!openSpill() || !m_spill.seek(m_spilled) || m_spill.write(p.m_data) != p.m_data.size()) {
+            e.m_offset = s_failed;
+
+            continue;
+        }
+
+        e.m_offset = m_spilled;
+        e.m_bytes = p.m_data.size();
+        m_spilled += e.m_bytes;
+    }
+}
+
+qsizetype FrameStore::count() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return m_entries.size();
+}
+
+bool FrameStore::isEmpty() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return m_entries.isEmpty();
+}
+
+QImage FrameStore::at(qsizetype idx) const
+{
+    QMutexLocker lock(&m_mutex);
+
+    // Frame may be still compressed by the pool.
+    while (m_entries.at(idx).m_offset == s_packing) {
+        drain();
+
+        if (m_entries.at(idx).m_offset != s_packing) {
+            break;
+        }
+
+        lock.unlock();
+        m_compressed.tryAcquire(1, s_packWait);
+        lock.relock();
+    }
+
+    const auto e = m_entries.at(idx);
+
+    if (e.m_offset == s_inMemory) {
+        return e.m_image;
+    }
+
+    if (e.m_offset < 0 || !m_spill.seek(e.m_offset)) {
+        return {};
+    }
+
+    const auto data = m_spill.read(e.m_bytes);
+
+    lock.unlock();
+
+    QImage img(e.m_rect.size(), e.m_format);
+
+    if (data.size() != e.m_bytes || img.isNull() || !qoiDecode(data, img)) {
+        return {};
+    }
+
+    return img;
+}
+
+QSize FrameStore::size(qsizetype idx) const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return m_entries.at(idx).m_rect.size();
+}
+
+QRect FrameStore::rect(qsizetype idx) const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return m_entries.at(idx).m_rect;
+}
+
+qint64 FrameStore::memoryUsage() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return m_memoryUsage;
+}
+
+qint64 FrameStore::spilledBytes() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return m_spilled;
+}
+
+qsizetype FrameStore::packingBacklog() const
+{
+    return m_backlog.load(std::memory_order_relaxed);
+}
+
+void FrameStore::clear()
+{
+    QMutexLocker lock(&m_mutex);
+
+    m_pool.waitForDone();
+
+    Packed p;
+
+    while (m_packed.pop(p)) {
+    }
+
+    m_compressed.tryAcquire(m_compressed.available());
+    m_backlog = 0;
+    m_entries.clear();
+    m_memoryUsage = 0;
+    m_spilled = 0;
+
+    if (m_spill.isOpen()) {
+        m_spill.resize(0);
+    }
+}
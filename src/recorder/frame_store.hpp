@@ -0,0 +1,129 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QByteArray>
+#include <QImage>
+#include <QMutex>
+#include <QSemaphore>
+#include <QTemporaryFile>
+#include <QThreadPool>
+#include <QVector>
+
+// C++ include.
+#include <atomic>
+
+// GIF recorder include.
+#include "frame_source.hpp"
+#include "mpsc_queue.hpp"
+
+//
+// FrameStore
+//
+
+//! Storage of raw recorded frames. Frames are kept in memory up to the
+//! budget, the rest is compressed by the pool of workers and packed into
+//! the single spill file with the index of frames. A frame may be only the
+//! changed part of the screen, it's drawn over the previous ones.
+//! Frames may be read in one thread while they are appended in another.
+class FrameStore final : public FrameSource
+{
+public:
+    //! Default memory budget, in bytes.
+    static constexpr qint64 s_defaultMemoryBudget = 512LL * 1024 * 1024;
+
+    explicit FrameStore(qint64 memoryBudget = s_defaultMemoryBudget);
+    ~FrameStore() override;
+
+    //! \return Memory budget, in bytes.
+    qint64 memoryBudget() const;
+    //! Set memory budget, in bytes. Affects only frames appended later.
+    void setMemoryBudget(qint64 bytes);
+
+    //! Append a copy of \a rect of the frame, the whole frame if \a rect is null.
+    //! \return false if frame can't be stored.
+    bool append(const QImage &img,
+                const QRect &rect = {});
+    //! \return Count of frames.
+    qsizetype count() const override;
+    //! \return Is store empty.
+    bool isEmpty() const;
+    //! \return Frame at the given index.
+    QImage at(qsizetype idx) const override;
+    //! \return Size of frame at the given index.
+    QSize size(qsizetype idx) const override;
+    //! \return Place of frame at the given index on the screen.
+    QRect rect(qsizetype idx) const override;
+
+    //! \return Bytes of pixels held in memory.
+    qint64 memoryUsage() const;
+    //! \return Bytes of compressed pixels written to the spill file.
+    qint64 spilledBytes() const;
+    //! \return Count of frames waiting for compression. Capture should slow down when it grows.
+    qsizetype packingBacklog() const;
+
+    //! Remove all frames.
+    void clear();
+
+private:
+    Q_DISABLE_COPY(FrameStore)
+
+    //! Entry of the store.
+    struct Entry {
+        //! Frame, if it's in memory.
+        QImage m_image;
+        //! Place of the frame on the screen.
+        QRect m_rect;
+        //! Format of the frame.
+        QImage::Format m_format = QImage::Format_Invalid;
+        //! Offset in the spill file, s_inMemory, s_packing or s_failed.
+        qint64 m_offset = s_inMemory;
+        //! Size of the frame in bytes, compressed if it's in the spill file.
+        qint64 m_bytes = 0;
+    }; // struct Entry
+
+    //! Compressed frame.
+    struct Packed {
+        //! Index of the frame.
+        qsizetype m_index = -1;
+        //! Compressed pixels.
+        QByteArray m_data;
+    }; // struct Packed
+
+    //! Frame is in memory.
+    static constexpr qint64 s_inMemory = -1;
+    //! Frame is being compressed.
+    static constexpr qint64 s_packing = -2;
+    //! Frame can't be written to the spill file.
+    static constexpr qint64 s_failed = -3;
+
+    //! Open spill file if it's not yet.
+    bool openSpill() const;
+    //! Write compressed frames to the spill file. Should be called under the guard.
+    void drain() const;
+
+    //! Guard.
+    mutable QMutex m_mutex;
+    //! Entries. Places of packed frames are set on reading too.
+    mutable QVector<Entry> m_entries;
+    //! Spill file.
+    mutable QTemporaryFile m_spill;
+    //! Memory budget.
+    qint64 m_memoryBudget;
+    //! Memory usage.
+    qint64 m_memoryUsage = 0;
+    //! Bytes in spill file.
+    mutable qint64 m_spilled = 0;
+    //! Compressing workers.
+    QThreadPool m_pool;
+    //! Frames compressed by workers.
+    mutable MpscQueue<Packed> m_packed;
+    //! Released by a worker when a frame is compressed.
+    mutable QSemaphore m_compressed;
+    //! Count of frames waiting for compression.
+    std::atomic<qsizetype> m_backlog{0};
+}; // class FrameStore
@@ -0,0 +1,352 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF recorder include.
+#include "gif_writer.hpp"
+#include "frame_composer.hpp"
+#include "palette.hpp"
+
+// giflib include.
+#include <gif_lib.h>
+
+namespace /* anonymous */
+{
+
+int writeToFile(GifFileType *gif,
+                const GifByteType *data,
+                int length)
+{
+    return static_cast<int>(static_cast<QFile *>(gif->UserData)->write(reinterpret_cast<const char *>(data), length));
+}
+
+//! \return Color map with count of colors rounded up to power of 2, as GIF requires.
+ColorMapObject *makeColorMap(const QVector<QRgb> &colors)
+{
+    int count = 2;
+
+    while (count < colors.size()) {
+        count *= 2;
+    }
+
+    std::vector<GifColorType> map(static_cast<size_t>(count), GifColorType{0, 0, 0});
+
+    for (qsizetype i = 0; i < colors.size(); ++i) {
+        auto &c = map[static_cast<size_t>(i)];
+        c.Red = static_cast<GifByteType>(qRed(colors.at(i)));
+        c.Green = static_cast<GifByteType>(qGreen(colors.at(i)));
+        c.Blue = static_cast<GifByteType>(qBlue(colors.at(i)));
+    }
+
+    return GifMakeMapObject(count, map.data());
+}
+
+} /* namespace anonymous */
+
+//
+// GifWriter
+//
+
+GifWriter::GifWriter(QObject *parent)
+    : QObject(parent)
+{
+}
+
+GifWriter::~GifWriter()
+{
+    close();
+}
+
+PaletteMode GifWriter::paletteMode() const
+{
+    return m_mode;
+}
+
+void GifWriter::setPaletteMode(PaletteMode mode)
+{
+    m_mode = mode;
+}
+
+bool GifWriter::write(const QString &fileName,
+                      FrameComposer &frames,
+                      const QVector<int> &delays,
+                      unsigned int loopCount,
+                      QPromise<bool> *promise)
+{
+    auto finish = [promise](bool ok) {
+        if (promise) {
+            promise->addResult(ok);
+        }
+
+        return ok;
+    };
+
+    if (frames.count() == 0 || !open(fileName, frames.size(0), loopCount)) {
+        return finish(false);
+    }
+
+    emit writeProgress(0);
+
+    const auto count = frames.count();
+    // Palette of all frames is built with the first pass.
+    const qsizetype passes = (m_mode == PaletteMode::Global ? 2 : 1);
+    int percent = 0;
+
+    auto progress = [&](qsizetype done) {
+        const auto p = static_cast<int>(done * 100 / (count * passes));
+
+        if (p != percent) {
+            percent = p;
+
+            emit writeProgress(percent);
+        }
+    };
+
+    if (m_mode == PaletteMode::Global) {
+        for (qsizetype i = 0; i < count; ++i) {
+            if (promise && promise->isCanceled()) {
+                close();
+
+                return finish(false);
+            }
+
+            const auto img = frames.take(i, count);
+
+            if (!img.isNull()) {
+                m_window.add(img.format() == QImage::Format_RGB32 || img.format() == QImage::Format_ARGB32
+                                 ? img
+                                 : img.convertToFormat(QImage::Format_RGB32));
+            }
+
+            progress(i + 1);
+        }
+
+        m_palette = Palette::build(m_window);
+        m_fixed = !m_palette.isEmpty();
+    }
+
+    for (qsizetype i = 0; i < count; ++i) {
+        if (promise && promise->isCanceled()) {
+            close();
+
+            return finish(false);
+        }
+
+        if (!writeFrame(frames.take(i, count), delays.value(i, 0), frames.rect(i).topLeft())) {
+            close();
+
+            return finish(false);
+        }
+
+        progress(count * (passes - 1) + i + 1);
+    }
+
+    return finish(close());
+}
+
+bool GifWriter::open(const QString &fileName,
+                     const QSize &size,
+                     unsigned int loopCount)
+{
+    close();
+
+    m_file.setFileName(fileName);
+
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    int error = 0;
+    m_gif = EGifOpen(&m_file, writeToFile, &error);
+
+    if (!m_gif) {
+        m_file.close();
+
+        return false;
+    }
+
+    m_size = size;
+    m_loopCount = loopCount;
+    m_headerWritten = false;
+    m_indices.resize(static_cast<size_t>(size.width()) * static_cast<size_t>(size.height()));
+    m_window.clear();
+    m_palette = Palette();
+    m_isGlobal = false;
+    m_fixed = false;
+
+    EGifSetGifVersion(m_gif, true);
+
+    // Screen descriptor is written with the first frame, when the global color table is known.
+    return true;
+}
+
+bool GifWriter::writeHeader(const Palette *global)
+{
+    ColorMapObject *map = nullptr;
+
+    if (global) {
+        map = makeColorMap(global->colors());
+
+        if (!map) {
+            return false;
+        }
+    }
+
+    const auto ok = (EGifPutScreenDesc(m_gif, m_size.width(), m_size.height(), 8, 0, map) != GIF_ERROR);
+
+    if (map) {
+        GifFreeMapObject(map);
+    }
+
+    if (!ok) {
+        return false;
+    }
+
+    m_headerWritten = true;
+
+    const GifByteType loop[3] = {1,
+                                 static_cast<GifByteType>(m_loopCount & 0xFF),
+                                 static_cast<GifByteType>((m_loopCount >> 8) & 0xFF)};
+
+    return (EGifPutExtensionLeader(m_gif, APPLICATION_EXT_FUNC_CODE) != GIF_ERROR
+            && EGifPutExtensionBlock(m_gif, 11, "NETSCAPE2.0") != GIF_ERROR
+            && EGifPutExtensionBlock(m_gif, 3, loop) != GIF_ERROR
+            && EGifPutExtensionTrailer(m_gif) != GIF_ERROR);
+}
+
+bool GifWriter::isOpen() const
+{
+    return (m_gif != nullptr);
+}
+
+bool GifWriter::writeFrame(const QImage &frame,
+                           int delay,
+                           const QPoint &pos)
+{
+    if (!m_gif || frame.isNull()) {
+        return false;
+    }
+
+    const auto r = QRect(pos, frame.size()) & QRect(QPoint(0, 0), m_size);
+
+    if (r.isEmpty()) {
+        return false;
+    }
+
+    QImage img = (frame.format() == QImage::Format_RGB32 || frame.format() == QImage::Format_ARGB32
+                      ? frame
+                      : frame.convertToFormat(QImage::Format_RGB32));
+
+    if (img.size() != r.size()) {
+        img = img.copy(QRect(r.topLeft() - pos, r.size()));
+    }
+
+    m_histogram.clear();
+    m_histogram.add(img);
+
+    const Palette *palette = &m_palette;
+    Palette own;
+
+    if (m_mode == PaletteMode::Local) {
+        m_palette = Palette::build(m_histogram);
+        m_isGlobal = false;
+    } else if (m_fixed) {
+        // Global color table stays, frame gets its own palette only if it doesn't fit.
+        if (!m_palette.covers(m_histogram)) {
+            own = Palette::build(m_histogram);
+            palette = &own;
+        }
+    } else {
+        m_window.decay();
+        m_window.add(m_histogram);
+
+        // Palette of the last frames is reused while it fits, so it doesn't flicker and has no cost.
+        if (!m_palette.covers(m_histogram)) {
+            m_palette = Palette::build(m_window);
+            m_isGlobal = false;
+        }
+    }
+
+    if (!m_headerWritten) {
+        const auto global = (m_mode != PaletteMode::Local);
+
+        if (!writeHeader(global ? &m_palette : nullptr)) {
+            return false;
+        }
+
+        m_isGlobal = global;
+    }
+
+    return writeImage(img, r.topLeft(), *palette, !(m_isGlobal && palette == &m_palette), delay);
+}
+
+bool GifWriter::writeImage(const QImage &img,
+                           const QPoint &pos,
+                           const Palette &palette,
+                           bool local,
+                           int delay)
+{
+    GraphicsControlBlock gcb;
+    gcb.DisposalMode = DISPOSE_DO_NOT;
+    gcb.UserInputFlag = false;
+    gcb.DelayTime = delay / 10;
+    gcb.TransparentColor = NO_TRANSPARENT_COLOR;
+
+    GifByteType ext[4];
+    EGifGCBToExtension(&gcb, ext);
+
+    if (EGifPutExtension(m_gif, GRAPHICS_EXT_FUNC_CODE, 4, ext) == GIF_ERROR) {
+        return false;
+    }
+
+    ColorMapObject *map = nullptr;
+
+    if (local) {
+        map = makeColorMap(palette.colors());
+
+        if (!map) {
+            return false;
+        }
+    }
+
+    const auto ok = (EGifPutImageDesc(m_gif, pos.x(), pos.y(), img.width(), img.height(), false, map) != GIF_ERROR);
+
+    if (map) {
+        GifFreeMapObject(map);
+    }
+
+    if (!ok) {
+        return false;
+    }
+
+    palette.map(img, img.rect(), m_indices.data());
+
+    for (int y = 0; y < img.height(); ++y) {
+        if (EGifPutLine(m_gif, m_indices.data() + static_cast<size_t>(y) * static_cast<size_t>(img.width()),
+                        img.width())
+            == GIF_ERROR) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool GifWriter::close()
+{
+    if (!m_gif) {
+        return false;
+    }
+
+    // GIF without frames still has the screen descriptor.
+    const auto header = (m_headerWritten || writeHeader(nullptr));
+
+    int error = 0;
+    const auto ok = (EGifCloseFile(m_gif, &error) != GIF_ERROR && header);
+    m_gif = nullptr;
+
+    m_file.close();
+
+    return ok;
+}
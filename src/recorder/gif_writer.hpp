@@ -0,0 +1,116 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QFile>
+#include <QImage>
+#include <QObject>
+#include <QPromise>
+#include <QVector>
+
+// C++ include.
+#include <vector>
+
+// GIF recorder include.
+#include "palette.hpp"
+
+class FrameComposer;
+struct GifFileType;
+
+//! Mode of palettes of frames.
+enum class PaletteMode {
+    //! Palette of every frame is built from the frame.
+    Local = 0,
+    //! Palette is reused while it fits frames and is rebuilt from the last frames when it doesn't.
+    //! The first palette is the global color table.
+    Stable,
+    //! Palette of all frames is the global color table, frames that don't fit it get their own.
+    //! Frames written one at a time with writeFrame() are written as in stable mode.
+    Global
+}; // enum class PaletteMode
+
+//
+// GifWriter
+//
+
+//! Writer of GIF from raw frames.
+class GifWriter final : public QObject
+{
+    Q_OBJECT
+
+signals:
+    //! Progress of writing in percents.
+    void writeProgress(int percent);
+
+public:
+    explicit GifWriter(QObject *parent = nullptr);
+    ~GifWriter() override;
+
+    //! \return Mode of palettes.
+    PaletteMode paletteMode() const;
+    //! Set mode of palettes, should be called before open().
+    void setPaletteMode(PaletteMode mode);
+
+    //! Write all frames composed with overlays. Result is added to the promise if it's given.
+    bool write(const QString &fileName,
+               FrameComposer &frames,
+               const QVector<int> &delays,
+               unsigned int loopCount = 0,
+               QPromise<bool> *promise = nullptr);
+
+    //! Open file and write header.
+    bool open(const QString &fileName,
+              const QSize &size,
+              unsigned int loopCount = 0);
+    //! \return Is file opened.
+    bool isOpen() const;
+    //! Write frame with delay in milliseconds. Frame may be a part of the screen at \a pos.
+    bool writeFrame(const QImage &img,
+                    int delay,
+                    const QPoint &pos = QPoint(0, 0));
+    //! Write trailer and close file.
+    bool close();
+
+private:
+    //! Write screen descriptor with the global color table if it's given.
+    bool writeHeader(const Palette *global);
+    //! Write image descriptor and pixels of the frame at \a pos quantized with the palette.
+    //! Color table of the frame is written if \a local.
+    bool writeImage(const QImage &img,
+                    const QPoint &pos,
+                    const Palette &palette,
+                    bool local,
+                    int delay);
+
+private:
+    Q_DISABLE_COPY(GifWriter)
+
+    //! File.
+    QFile m_file;
+    //! GIF handle.
+    GifFileType *m_gif = nullptr;
+    //! Size of the screen.
+    QSize m_size;
+    //! Loop count.
+    unsigned int m_loopCount = 0;
+    //! Is screen descriptor written.
+    bool m_headerWritten = false;
+    //! Buffer of color indices.
+    std::vector<uchar> m_indices;
+    //! Mode of palettes.
+    PaletteMode m_mode = PaletteMode::Local;
+    //! Histogram of the current frame.
+    Histogram m_histogram;
+    //! Histogram of the last frames in stable mode, of all frames in global mode.
+    Histogram m_window;
+    //! Palette of the last frame.
+    Palette m_palette;
+    //! Is the palette the global color table.
+    bool m_isGlobal = false;
+    //! Palette of all frames is known, it's never rebuilt.
+    bool m_fixed = false;
+}; // class GifWriter
@@ -0,0 +1,283 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF recorder include.
+#include "headless.hpp"
+#include "capture.hpp"
+
+// shared include.
+#include "project.hpp"
+
+// Qt include.
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QHash>
+#include <QScreen>
+#include <QTextStream>
+#include <QTimer>
+
+// C++ include.
+#include <csignal>
+#include <cstring>
+
+namespace /* anonymous */
+{
+
+//! How often stop conditions are checked, in milliseconds.
+const int s_checkInterval = 50;
+
+//! Termination signal was received.
+volatile std::sig_atomic_t s_interrupted = 0;
+
+extern "C" void onSignal(int)
+{
+    s_interrupted = 1;
+}
+
+//! \return Stream for messages.
+QTextStream &err()
+{
+    static QTextStream stream(stderr);
+
+    return stream;
+}
+
+//! \return Rect parsed from "x,y,w,h", null if format is wrong.
+QRect parseRegion(const QString &value)
+{
+    const auto parts = value.split(QLatin1Char(','));
+
+    if (parts.size() != 4) {
+        return {};
+    }
+
+    int v[4];
+
+    for (int i = 0; i < 4; ++i) {
+        bool ok = false;
+        v[i] = parts.at(i).trimmed().toInt(&ok);
+
+        if (!ok) {
+            return {};
+        }
+    }
+
+    return QRect(v[0], v[1], v[2], v[3]);
+}
+
+} /* namespace anonymous */
+
+bool isHeadless(int argc,
+                char **argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--output") == 0 || std::strncmp(argv[i], "--output=", 9) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int runHeadless()
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Record GIF of the screen region without user interface."));
+    const auto helpOption = parser.addHelpOption();
+
+    const QCommandLineOption regionOption(QStringLiteral("region"),
+                                          QStringLiteral("Region of the screen to record, in global coordinates."),
+                                          QStringLiteral("x,y,w,h"));
+    const QCommandLineOption fpsOption(QStringLiteral("fps"),
+                                       QStringLiteral("Frames per second."),
+                                       QStringLiteral("N"),
+                                       QStringLiteral("24"));
+    const QCommandLineOption durationOption(QStringLiteral("duration"),
+                                            QStringLiteral("Duration of recording, in seconds."),
+                                            QStringLiteral("S"));
+    const QCommandLineOption untilSignalOption(QStringLiteral("until-signal"),
+                                               QStringLiteral("Record till SIGINT or SIGTERM."));
+    const QCommandLineOption outputOption(QStringLiteral("output"),
+                                          QStringLiteral("File to write GIF to, or the project for the editor "
+                                                         "if its suffix is .%1.")
+                                              .arg(projectSuffix()),
+                                          QStringLiteral("file.gif"));
+    const QCommandLineOption noCursorOption(QStringLiteral("no-cursor"),
+                                            QStringLiteral("Don't draw mouse cursor."));
+    const QCommandLineOption downscaleOption(QStringLiteral("downscale"),
+                                             QStringLiteral("Reduce frames N times, e.g. 2 records HiDPI screen "
+                                                            "in logical pixels."),
+                                             QStringLiteral("N"),
+                                             QStringLiteral("1"));
+    const QCommandLineOption paletteOption(QStringLiteral("palette"),
+                                           QStringLiteral("Colors of GIF: local builds them for every frame, stable "
+                                                          "keeps them while they fit frames, global builds them "
+                                                          "for all frames."),
+                                           QStringLiteral("local|stable|global"),
+                                           QStringLiteral("stable"));
+
+    parser.addOptions({regionOption,
+                       fpsOption,
+                       durationOption,
+                       untilSignalOption,
+                       outputOption,
+                       noCursorOption,
+                       downscaleOption,
+                       paletteOption});
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        err() << parser.errorText() << Qt::endl;
+
+        return HeadlessBadArguments;
+    }
+
+    if (parser.isSet(helpOption)) {
+        err() << parser.helpText() << Qt::flush;
+
+        return HeadlessOk;
+    }
+
+    const auto fileName = parser.value(outputOption);
+
+    if (fileName.isEmpty()) {
+        err() << QStringLiteral("Output file is not set.") << Qt::endl;
+
+        return HeadlessBadArguments;
+    }
+
+    bool ok = false;
+    const auto fps = parser.value(fpsOption).toInt(&ok);
+
+    if (!ok || fps < 1 || fps > 100) {
+        err() << QStringLiteral("Frames per second should be from 1 to 100.") << Qt::endl;
+
+        return HeadlessBadArguments;
+    }
+
+    const auto downscale = parser.value(downscaleOption).toInt(&ok);
+
+    if (!ok || downscale < 1 || downscale > 4) {
+        err() << QStringLiteral("Downscale should be from 1 to 4.") << Qt::endl;
+
+        return HeadlessBadArguments;
+    }
+
+    static const QHash<QString, PaletteMode> paletteModes = {{QStringLiteral("local"), PaletteMode::Local},
+                                                             {QStringLiteral("stable"), PaletteMode::Stable},
+                                                             {QStringLiteral("global"), PaletteMode::Global}};
+
+    const auto palette = parser.value(paletteOption).toLower();
+
+    if (!paletteModes.contains(palette)) {
+        err() << QStringLiteral("Palette should be local, stable or global.") << Qt::endl;
+
+        return HeadlessBadArguments;
+    }
+
+    qint64 duration = -1;
+
+    if (parser.isSet(durationOption)) {
+        duration = static_cast<qint64>(parser.value(durationOption).toDouble(&ok) * 1000.0);
+
+        if (!ok || duration <= 0) {
+            err() << QStringLiteral("Duration should be a positive number of seconds.") << Qt::endl;
+
+            return HeadlessBadArguments;
+        }
+    }
+
+    if (parser.isSet(durationOption) == parser.isSet(untilSignalOption)) {
+        err() << QStringLiteral("Exactly one of --duration or --until-signal should be set.") << Qt::endl;
+
+        return HeadlessBadArguments;
+    }
+
+    auto screen = QGuiApplication::primaryScreen();
+
+    if (!screen) {
+        err() << QStringLiteral("There is no screen to record.") << Qt::endl;
+
+        return HeadlessCaptureFailed;
+    }
+
+    auto rect = screen->geometry();
+
+    if (parser.isSet(regionOption)) {
+        rect = parseRegion(parser.value(regionOption));
+
+        if (rect.isEmpty()) {
+            err() << QStringLiteral("Region should be x,y,w,h with positive width and height.") << Qt::endl;
+
+            return HeadlessBadArguments;
+        }
+
+        auto s = QGuiApplication::screenAt(rect.center());
+
+        if (!s || !s->geometry().contains(rect)) {
+            err() << QStringLiteral("Region should be inside one screen.") << Qt::endl;
+
+            return HeadlessBadArguments;
+        }
+
+        screen = s;
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    CaptureSettings settings;
+    settings.m_screen = screen;
+    settings.m_rect = rect;
+    settings.m_downscale = downscale;
+    settings.m_paletteMode = paletteModes.value(palette);
+    settings.m_fps = fps;
+    settings.m_grabCursor = !parser.isSet(noCursorOption);
+    settings.m_drawMouseClick = false;
+    settings.m_grabKeys = false;
+
+    Capture capture;
+    capture.start(settings);
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    QTimer check;
+    QObject::connect(&check, &QTimer::timeout, [&]() {
+        if (s_interrupted || (duration > 0 && elapsed.elapsed() >= duration)) {
+            QCoreApplication::quit();
+        }
+    });
+    check.start(s_checkInterval);
+
+    QCoreApplication::exec();
+
+    check.stop();
+    capture.stop();
+
+    err() << QStringLiteral("Captured %1 frame(s), %2 dropped tick(s), %3 duplicate(s).")
+                 .arg(capture.capturedFrames())
+                 .arg(capture.droppedFrames())
+                 .arg(capture.duplicateFrames())
+          << Qt::endl;
+
+    if (capture.frames().isEmpty()) {
+        err() << QStringLiteral("Nothing was captured.") << Qt::endl;
+
+        return HeadlessCaptureFailed;
+    }
+
+    const auto written = (QFileInfo(fileName).suffix().toLower() == projectSuffix() ? capture.saveProject(fileName)
+                                                                                    : capture.save(fileName));
+
+    if (!written) {
+        err() << QStringLiteral("Can't write %1.").arg(fileName) << Qt::endl;
+
+        return HeadlessWriteFailed;
+    }
+
+    return HeadlessOk;
+}
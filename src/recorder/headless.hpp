@@ -0,0 +1,27 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+//! Exit codes of the headless run.
+enum HeadlessExitCode {
+    //! GIF is recorded.
+    HeadlessOk = 0,
+    //! Wrong command line.
+    HeadlessBadArguments = 1,
+    //! Nothing was captured.
+    HeadlessCaptureFailed = 2,
+    //! GIF can't be written.
+    HeadlessWriteFailed = 3
+}; // enum HeadlessExitCode
+
+//! \return Is recorder started from the command line without widgets.
+bool isHeadless(int argc,
+                char **argv);
+
+//! Record GIF as described by the command line of the application. Should be
+//! called after the application object is created.
+//! \return Exit code, one of HeadlessExitCode.
+int runHeadless();
@@ -0,0 +1,48 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF recorder include.
+#include "input_events.hpp"
+
+// Qt include.
+#include <QMutexLocker>
+
+// C++ include.
+#include <chrono>
+
+qint64 monotonicNow()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+//
+// InputEvents
+//
+
+bool InputEvents::push(const InputEvent &e)
+{
+    return m_events.push(e);
+}
+
+bool InputEvents::pop(InputEvent &e)
+{
+    return m_events.pop(e);
+}
+
+void InputEvents::setKeyName(quint32 key,
+                             const QString &name)
+{
+    QMutexLocker lock(&m_namesMutex);
+
+    m_names.insert(key, name);
+}
+
+QString InputEvents::keyName(quint32 key) const
+{
+    QMutexLocker lock(&m_namesMutex);
+
+    return m_names.value(key);
+}
@@ -0,0 +1,77 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+// GIF recorder include.
+#include "spsc_ring.hpp"
+
+//
+// InputEvent
+//
+
+//! Input event.
+struct InputEvent {
+    //! Type of the event.
+    enum Type : quint8 {
+        ButtonPress = 0,
+        ButtonRelease,
+        KeyPress,
+        KeyRelease
+    }; // enum Type
+
+    //! Monotonic time of the event, in nanoseconds. See monotonicNow().
+    qint64 m_timestamp = 0;
+    //! Key symbol, its name is given by InputEvents::keyName().
+    quint32 m_key = 0;
+    //! Type.
+    Type m_type = ButtonPress;
+    //! Mouse button.
+    quint8 m_button = 0;
+}; // struct InputEvent
+
+//! \return Monotonic time in nanoseconds, the clock of capture timestamps.
+qint64 monotonicNow();
+
+//
+// InputEvents
+//
+
+//! Queue of input events from the event monitor to the capture. Names of keys
+//! are interned once per key, events themselves carry only the key symbol.
+class InputEvents final
+{
+public:
+    //! Capacity of the queue. Events are dropped when it's full.
+    static constexpr std::size_t s_capacity = 1024;
+
+    InputEvents() = default;
+
+    //! Push event, should be called by the event monitor only. \return false if the event is dropped.
+    bool push(const InputEvent &e);
+    //! Pop event, should be called by the capture only. \return false if there are no events.
+    bool pop(InputEvent &e);
+
+    //! Remember name of the key.
+    void setKeyName(quint32 key,
+                    const QString &name);
+    //! \return Name of the key.
+    QString keyName(quint32 key) const;
+
+private:
+    Q_DISABLE_COPY(InputEvents)
+
+    //! Events.
+    SpscRing<InputEvent, s_capacity> m_events;
+    //! Guard of names. The event monitor takes it only when it meets a new key.
+    mutable QMutex m_namesMutex;
+    //! Names of keys.
+    QHash<quint32, QString> m_names;
+}; // class InputEvents
@@ -13,6 +13,7 @@
 
 // GIF recorder include.
 #include "event_monitor.hpp"
+#include "headless.hpp"
 #include "mainwindow.hpp"
 
 // gif-widgets include.
@@ -25,15 +26,22 @@
 int main(int argc,
          char **argv)
 {
+    QCoreApplication::setOrganizationName(QStringLiteral("Igor Mironchik"));
+    QCoreApplication::setOrganizationDomain(QStringLiteral("github.com/igormironchik"));
+    QCoreApplication::setApplicationName(QStringLiteral("GIF Recorder"));
+
+    // Recording from the command line, e.g. under Xvfb in CI, doesn't need widgets.
+    if (isHeadless(argc, argv)) {
+        QGuiApplication app(argc, argv);
+
+        return runHeadless();
+    }
+
 #ifdef MD_BREEZE
     KIconTheme::initTheme();
 #endif
     QApplication app(argc, argv);
 
-    app.setOrganizationName(QStringLiteral("Igor Mironchik"));
-    app.setOrganizationDomain(QStringLiteral("github.com/igormironchik"));
-    app.setApplicationName(QStringLiteral("GIF Recorder"));
-
     initTheme(app);
 
     initSharedResources();
@@ -5,16 +5,17 @@
 
 // GIF recorder include.
 #include "mainwindow.hpp"
+#include "capture.hpp"
 #include "event_monitor.hpp"
 #include "settings.hpp"
 #include "sizedlg.hpp"
 
-// qgiflib include.
-#include <qgiflib.hpp>
-
 // QHotKey include.
 #include <QHotkey/qhotkey.h>
 
+// shared include.
+#include "project.hpp"
+
 // gif-widgets include.
 #include "license_dialog.hpp"
 #include "utils.hpp"
@@ -23,8 +24,10 @@
 // Qt include.
 #include <QApplication>
 #include <QCloseEvent>
+#include <QDateTime>
 #include <QDir>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QGridLayout>
 #include <QHBoxLayout>
 #include <QMenu>
@@ -34,6 +37,7 @@
 #include <QPainter>
 #include <QPainterPath>
 #include <QPalette>
+#include <QProcess>
 #include <QPromise>
 #include <QResizeEvent>
 #include <QScreen>
@@ -43,20 +47,13 @@
 #include <QStyleHints>
 #include <QtConcurrent>
 
-#ifdef Q_OS_LINUX
-#include <X11/Xlib.h>
-#include <X11/extensions/Xfixes.h>
-#endif
-
-#ifdef Q_OS_WINDOWS
-#include <Windows.h>
-#endif
-
 #if defined(Q_OS_WIN) && defined(MD_BREEZE)
 #include <KColorSchemeManager>
 #endif
 
 static const int s_handleRadius = 9;
+//! Interval of updating of live statistics, in milliseconds.
+static const int s_statsInterval = 500;
 
 //
 // Title
@@ -386,8 +383,9 @@ MainWindow::MainWindow(EventMonitor *eventMonitor)
     : QWidget(nullptr)
     , m_title(new TitleWidget(this,
                               this))
-    , m_timer(new QTimer(this))
-    , m_keysTimer(new QTimer(this))
+    , m_capture(new Capture(this))
+    , m_events(eventMonitor->events())
+    , m_statsTimer(new QTimer(this))
 {
     setAttribute(Qt::WA_TranslucentBackground, true);
     setWindowState(Qt::WindowFullScreen);
@@ -404,6 +402,7 @@ MainWindow::MainWindow(EventMonitor *eventMonitor)
     const auto y = (screenSize.height() - height) / 2;
 
     auto startStopAction = new QHotkey(QStringLiteral("Ctrl+0"), true, this);
+    auto saveReplayAction = new QHotkey(QStringLiteral("Ctrl+9"), true, this);
 
     resize(screenSize);
 
@@ -412,20 +411,14 @@ MainWindow::MainWindow(EventMonitor *eventMonitor)
     m_title->setMinimumWidth(width);
     m_title->move(screenSize.width() / 2 - width / 2, s_handleRadius);
 
-    m_keysTimer->setSingleShot(true);
-
     connect(m_title->closeButton(), &CloseButton::clicked, qApp, &QApplication::quit);
-    connect(m_timer, &QTimer::timeout, this, &MainWindow::onTimer);
-    connect(m_keysTimer, &QTimer::timeout, [this]() {
-        this->m_key.clear();
-    });
-    connect(eventMonitor, &EventMonitor::buttonPress, this, &MainWindow::onMousePressed, Qt::QueuedConnection);
-    connect(eventMonitor, &EventMonitor::buttonRelease, this, &MainWindow::onMouseReleased, Qt::QueuedConnection);
-    connect(eventMonitor, &EventMonitor::keyPressed, this, &MainWindow::onKeyPressed, Qt::QueuedConnection);
-    connect(eventMonitor, &EventMonitor::keyReleased, this, &MainWindow::onKeyReleased, Qt::QueuedConnection);
+    connect(m_capture, &Capture::writeProgress, this, &MainWindow::onWritePercent);
+    connect(m_statsTimer, &QTimer::timeout, this, &MainWindow::onStatsTimer);
     connect(m_title, &TitleWidget::resizeRequested, this, &MainWindow::onResizeRequested);
     connect(m_title->recordButton(), &QToolButton::clicked, this, &MainWindow::onRecord);
     connect(startStopAction, &QHotkey::activated, this, &MainWindow::onRecord);
+    connect(saveReplayAction, &QHotkey::activated, this, &MainWindow::onSaveReplay);
+    connect(&m_replayWatcher, &QFutureWatcher<bool>::finished, this, &MainWindow::onReplaySaved);
     connect(m_title->transparentForMouseButton(), &QToolButton::toggled, this, &MainWindow::onTransparentForMouse);
 
     auto mask = QBitmap(s_handleRadius * 2, s_handleRadius * 2);
@@ -474,13 +467,29 @@ MainWindow::MainWindow(EventMonitor *eventMonitor)
 
 void MainWindow::onSettings()
 {
-    Settings dlg(m_fps, m_grabCursor, m_drawMouseClick, m_grabKeys, this);
+    Settings dlg(m_fps,
+                 m_adaptiveFps,
+                 m_grabCursor,
+                 m_drawMouseClick,
+                 m_grabKeys,
+                 m_memoryBudget,
+                 m_showStats,
+                 m_downscale,
+                 m_replaySeconds,
+                 m_paletteMode,
+                 this);
 
     if (dlg.exec() == QDialog::Accepted) {
         m_fps = dlg.fps();
+        m_adaptiveFps = dlg.adaptiveFps();
         m_grabCursor = dlg.grabCursor();
         m_drawMouseClick = dlg.drawMouseClicks();
         m_grabKeys = dlg.drawKeyboardKeysPresses();
+        m_memoryBudget = dlg.memoryBudget();
+        m_showStats = dlg.showStats();
+        m_downscale = dlg.downscale();
+        m_replaySeconds = dlg.replaySeconds();
+        m_paletteMode = dlg.paletteMode();
     }
 }
 
@@ -502,21 +511,69 @@ void MainWindow::onRecord()
 
             update();
 
-            m_timer->stop();
+            m_capture->stop();
 
-            const auto dirs = QStandardPaths::standardLocations(QStandardPaths::PicturesLocation);
-            const auto defaultDir = dirs.first();
-
-            auto fileName = QFileDialog::getSaveFileName(this, tr("Save As"), defaultDir, tr("GIF (*.gif)"));
+            if (m_statsTimer->isActive()) {
+                m_statsTimer->stop();
+                m_title->msg()->setText({});
+                m_title->msg()->setPalette(m_title->palette());
+            }
 
-            if (!fileName.isEmpty()) {
-                if (!fileName.toLower().endsWith(".gif")) {
-                    fileName.append(".gif");
+            const auto editor = editorExecutable();
+            bool saveFrames = true;
+
+            if (!editor.isEmpty()) {
+                QMessageBox box(QMessageBox::Question,
+                                tr("Recording is finished..."),
+                                tr("Save recorded frames or open them in GIF editor?"),
+                                QMessageBox::NoButton,
+                                this);
+                auto saveButton = box.addButton(tr("Save As..."), QMessageBox::AcceptRole);
+                auto editButton = box.addButton(tr("Open in Editor"), QMessageBox::ActionRole);
+                box.addButton(QMessageBox::Discard);
+                box.setDefaultButton(saveButton);
+                box.exec();
+
+                if (box.clickedButton() == editButton) {
+                    saveFrames = false;
+
+                    openInEditor(editor);
+                } else if (box.clickedButton() != saveButton) {
+                    saveFrames = false;
+
+                    clear();
                 }
+            }
+
+            if (saveFrames) {
+                const auto dirs = QStandardPaths::standardLocations(QStandardPaths::PicturesLocation);
+                const auto defaultDir = dirs.first();
+
+                const auto gifFilter = tr("GIF (*.gif)");
+                const auto projectFilter = tr("GIF recorder project (*.%1)").arg(projectSuffix());
+                QString filter;
+
+                auto fileName = QFileDialog::getSaveFileName(this,
+                                                             tr("Save As"),
+                                                             defaultDir,
+                                                             gifFilter + QStringLiteral(";;") + projectFilter,
+                                                             &filter);
+
+                if (!fileName.isEmpty()) {
+                    const auto suffix = QFileInfo(fileName).suffix().toLower();
 
-                save(fileName);
-            } else {
-                clear();
+                    if (filter == projectFilter) {
+                        if (suffix != projectSuffix()) {
+                            fileName.append(QStringLiteral(".") + projectSuffix());
+                        }
+                    } else if (suffix != QStringLiteral("gif") && suffix != projectSuffix()) {
+                        fileName.append(".gif");
+                    }
+
+                    save(fileName);
+                } else {
+                    clear();
+                }
             }
         } else {
             m_skipQuitEvent = true;
@@ -534,42 +591,32 @@ void MainWindow::onRecord()
 
             update();
 
-            m_timer->start(1000 / m_fps);
-            m_dir = QTemporaryDir(QDir::tempPath() + QDir::separator() + QStringLiteral("gif-recorder"));
-            m_elapsed.start();
-            makeFrame();
+            CaptureSettings settings;
+            settings.m_rect = QRect(mapToGlobal(m_rect.topLeft()), m_rect.size());
+            settings.m_screen = screenFor(settings.m_rect);
+            settings.m_downscale = m_downscale;
+            settings.m_fps = m_fps;
+            settings.m_adaptiveFps = m_adaptiveFps;
+            settings.m_grabCursor = m_grabCursor;
+            settings.m_drawMouseClick = m_drawMouseClick;
+            settings.m_grabKeys = m_grabKeys;
+            settings.m_events = m_events;
+            settings.m_memoryBudget = static_cast<qint64>(m_memoryBudget) * 1024 * 1024;
+            settings.m_replayDuration = static_cast<qint64>(m_replaySeconds) * 1000;
+            settings.m_paletteMode = m_paletteMode;
+
+            m_capture->start(settings);
+
+            if (m_showStats) {
+                m_lastStats = {};
+                m_statsTimer->start(s_statsInterval);
+            }
         }
 
         m_recording = !m_recording;
     }
 }
 
-void MainWindow::onTimer()
-{
-    makeFrame();
-}
-
-void MainWindow::onMousePressed()
-{
-    m_isMouseButtonPressed = true;
-}
-
-void MainWindow::onMouseReleased()
-{
-    m_isMouseButtonPressed = false;
-}
-
-void MainWindow::onKeyPressed(const QString &key)
-{
-    m_key = key.toUpper();
-}
-
-void MainWindow::onKeyReleased(const QString &)
-{
-    m_keysTimer->stop();
-    m_keysTimer->start(500);
-}
-
 void MainWindow::onResizeRequested()
 {
     SizeDlg dlg(m_rect.width(), m_rect.height(), this);
@@ -600,273 +647,165 @@ void MainWindow::onTransparentForMouse(bool checked)
 namespace /* anonymous */
 {
 
-#ifdef Q_OS_LINUX
-
-QImage qimageFromXImage(XImage *xi)
+void writeGIF(QPromise<bool> &promise,
+              MainWindow *progressReceiver,
+              Capture *capture,
+              const QString &fileName)
 {
-    QImage::Format format = QImage::Format_ARGB32_Premultiplied;
-    if (xi->depth == 24) {
-        format = QImage::Format_RGB32;
-    } else if (xi->depth == 16) {
-        format = QImage::Format_RGB16;
-    }
+    const auto isProject = (QFileInfo(fileName).suffix().toLower() == projectSuffix());
+    const auto ok = (isProject ? capture->saveProject(fileName, &promise) : capture->save(fileName, &promise));
 
-    QImage image =
-        QImage(reinterpret_cast<uchar *>(xi->data), xi->width, xi->height, xi->bytes_per_line, format).copy();
-
-    if ((QSysInfo::ByteOrder == QSysInfo::LittleEndian && xi->byte_order == MSBFirst)
-        || (QSysInfo::ByteOrder == QSysInfo::BigEndian && xi->byte_order == LSBFirst)) {
-        for (int i = 0; i < image.height(); ++i) {
-            if (xi->depth == 16) {
-                ushort *p = reinterpret_cast<ushort *>(image.scanLine(i));
-                ushort *end = p + image.width();
-                while (p < end) {
-                    *p = ((*p << 8) & 0xff00) | ((*p >> 8) & 0x00ff);
-                    ++p;
-                }
-            } else {
-                uint *p = reinterpret_cast<uint *>(image.scanLine(i));
-                uint *end = p + image.width();
-                while (p < end) {
-                    *p = ((*p << 24) & 0xff000000)
-                        | ((*p << 8) & 0x00ff0000)
-                        | ((*p >> 8) & 0x0000ff00)
-                        | ((*p >> 24) & 0x000000ff);
-                    ++p;
-                }
-            }
-        }
+    if (!ok) {
+        int methodIndex = progressReceiver->metaObject()->indexOfMethod("onWritePercent(int)");
+        QMetaMethod method = progressReceiver->metaObject()->method(methodIndex);
+        method.invoke(progressReceiver, Qt::QueuedConnection, 100);
     }
+}
 
-    if (format == QImage::Format_RGB32) {
-        QRgb *p = reinterpret_cast<QRgb *>(image.bits());
-        for (int y = 0; y < xi->height; ++y) {
-            for (int x = 0; x < xi->width; ++x) {
-                p[x] |= 0xff000000;
-            }
-            p += xi->bytes_per_line / 4;
-        }
+void shareForEditor(QPromise<bool> &promise,
+                    MainWindow *progressReceiver,
+                    Capture *capture,
+                    const QString &name)
+{
+    if (!capture->shareProject(name, &promise)) {
+        int methodIndex = progressReceiver->metaObject()->indexOfMethod("onWritePercent(int)");
+        QMetaMethod method = progressReceiver->metaObject()->method(methodIndex);
+        method.invoke(progressReceiver, Qt::QueuedConnection, 100);
     }
-
-    return image;
 }
 
-#endif // Q_OS_LINUX
+} /* namespase anonymous */
 
-std::tuple<QImage,
-           QRect,
-           QPoint> grabMouseCursor(const QRect &r,
-                                   const QImage &i)
+QString MainWindow::editorExecutable()
 {
-    QImage cursorImage;
-    QPoint cursorPos(-1, -1);
-    QPoint clickPos(-1, -1);
-    int w = 0;
-    int h = 0;
-
 #ifdef Q_OS_LINUX
-    Display *display = XOpenDisplay(nullptr);
+    // Editor is installed besides the recorder.
+    const auto fileName = QDir(QCoreApplication::applicationDirPath()).filePath(QStringLiteral("gif-editor"));
 
-    if (!display) {
-        return {cursorImage, {cursorPos, QSize(w, h)}, clickPos};
+    if (QFileInfo(fileName).isExecutable()) {
+        return fileName;
     }
 
-    XFixesCursorImage *cursor = XFixesGetCursorImage(display);
-
-    cursorPos =
-        r.intersects({QPoint(cursor->x - cursor->xhot, cursor->y - cursor->yhot), QSize(cursor->width, cursor->height)})
-        ? QPoint(cursor->x - cursor->xhot - r.x(), cursor->y - cursor->yhot - r.y())
-        : QPoint(-1, -1);
-
-    std::vector<uint32_t> pixels(cursor->width * cursor->height);
-
-    w = cursorPos.x() != -1 ? cursor->width : 0;
-    h = cursorPos.y() != -1 ? cursor->height : 0;
-
-    clickPos = QPoint(cursor->x - r.x(), cursor->y - r.y());
-
-    for (size_t i = 0; i < pixels.size(); ++i) {
-        pixels[i] = cursor->pixels[i];
-    }
-
-    cursorImage = QImage((uchar *)(pixels.data()), w, h, QImage::Format_ARGB32_Premultiplied).copy();
-
-    XFree(cursor);
-
-    XCloseDisplay(display);
-
-#elif defined(Q_OS_WINDOWS)
-    CURSORINFO cursor = {sizeof(cursor)};
-
-    if (GetCursorInfo(&cursor) && cursor.flags == CURSOR_SHOWING) {
-        ICONINFO info = {sizeof(info)};
-
-        if (GetIconInfo(cursor.hCursor, &info)) {
-            HWND hWnd = GetDesktopWindow();
-            HDC hDC = GetWindowDC(hWnd);
-            HDC hdcMem = CreateCompatibleDC(hDC);
-            BITMAP bmpCursor = {0};
-            GetObject(info.hbmColor ? info.hbmColor : info.hbmMask, sizeof(bmpCursor), &bmpCursor);
-            HBITMAP hBitmap = CreateCompatibleBitmap(hDC, bmpCursor.bmWidth, bmpCursor.bmHeight);
-            auto original = SelectObject(hdcMem, hBitmap);
-
-            const QPoint ctl(cursor.ptScreenPos.x - info.xHotspot, cursor.ptScreenPos.y - info.yHotspot);
-            w = bmpCursor.bmWidth;
-            h = bmpCursor.bmHeight;
-
-            for (int x = 0; x < w; ++x) {
-                for (int y = 0; y < h; ++y) {
-                    const QPoint c = QPoint(x, y) + ctl;
-
-                    if (r.contains(c)) {
-                        const auto color = i.pixelColor(c - r.topLeft());
-                        SetPixel(hdcMem, x, y, RGB(color.red(), color.green(), color.blue()));
-                    }
-                }
-            }
-
-            DrawIconEx(hdcMem, 0, 0, cursor.hCursor, 0, 0, 0, nullptr, DI_DEFAULTSIZE | DI_NORMAL);
+    return QStandardPaths::findExecutable(QStringLiteral("gif-editor"));
+#else
+    // Frames are passed through POSIX shared memory, segments grow on writes only on Linux.
+    return {};
+#endif
+}
 
-            QImage img(bmpCursor.bmWidth, bmpCursor.bmHeight, QImage::Format_ARGB32);
-            img.fill(Qt::transparent);
+void MainWindow::openInEditor(const QString &editor)
+{
+    m_title->recordButton()->setEnabled(false);
+    m_title->settingsButton()->setEnabled(false);
+    m_title->msg()->setText(tr("Passing frames to GIF editor... Please wait."));
 
-            for (int x = 0; x < w; ++x) {
-                for (int y = 0; y < h; ++y) {
-                    const QPoint c = QPoint(x, y) + ctl;
+    m_busy = true;
+    m_editor = editor;
+    m_sharedProject = sharedProjectName();
 
-                    if (r.contains(c)) {
-                        const auto winColor = GetPixel(hdcMem, x, y);
-                        const auto color1 = i.pixelColor(c - r.topLeft());
-                        const auto color2 = QColor(GetRValue(winColor), GetGValue(winColor), GetBValue(winColor));
+    m_capture->setOverlayOptions(overlayOptions());
 
-                        if (color1 != color2) {
-                            img.setPixelColor(x, y, color2);
-                        }
-                    }
-                }
-            }
+    connect(&m_watcher, &QFutureWatcher<void>::finished, this, &MainWindow::onProjectShared);
+    auto future = QtConcurrent::run(shareForEditor, this, m_capture, m_sharedProject);
+    m_watcher.setFuture(future);
+}
 
-            cursorPos = r.intersects({ctl, QSize(w, h)}) ? ctl - r.topLeft() : QPoint(-1, -1);
-            w = cursorPos.x() != -1 ? w : 0;
-            h = cursorPos.y() != -1 ? h : 0;
-            clickPos = QPoint(cursor.ptScreenPos.x - r.x(), cursor.ptScreenPos.y - r.y());
-            cursorImage = img.copy();
+void MainWindow::onProjectShared()
+{
+    disconnect(&m_watcher, 0, this, 0);
 
-            if (info.hbmMask) {
-                DeleteObject(info.hbmMask);
-            }
+    m_busy = false;
 
-            if (info.hbmColor) {
-                DeleteObject(info.hbmColor);
-            }
+    m_title->recordButton()->setEnabled(true);
+    m_title->settingsButton()->setEnabled(true);
+    m_title->msg()->setText({});
 
-            SelectObject(hdcMem, original);
+    if (!m_watcher.isCanceled() && m_watcher.future().result()) {
+        // Editor removes the segment when it's opened.
+        if (!QProcess::startDetached(m_editor, {QStringLiteral("--shared"), m_sharedProject})) {
+            removeSharedProject(m_sharedProject);
 
-            DeleteDC(hdcMem);
-            DeleteObject(hBitmap);
-        }
-
-        if (cursor.hCursor) {
-            DeleteObject(cursor.hCursor);
+            QMessageBox::critical(this, tr("Unable to open GIF editor..."), tr("Unable to start %1.").arg(m_editor));
         }
+    } else if (!m_watcher.isCanceled()) {
+        QMessageBox::critical(this,
+                              tr("Unable to open GIF editor..."),
+                              tr("Unable to pass frames to GIF editor, there is not enough shared memory."));
     }
-#endif
 
-    return {cursorImage, {cursorPos, QSize(w, h)}, clickPos};
-}
+    m_sharedProject.clear();
 
-} /* namespace anonymous */
+    clear();
+}
 
-void MainWindow::makeFrame()
+void MainWindow::save(const QString &fileName)
 {
-    m_delays.push_back(m_elapsed.elapsed());
-    m_elapsed.restart();
-
-    const auto p = mapToGlobal(QPoint(m_rect.x(), m_rect.y()));
-    const auto s = QSize(m_rect.width(), m_rect.height());
-
-    auto qimg = QApplication::primaryScreen()->grabWindow(0, p.x(), p.y(), s.width(), s.height()).toImage();
-
-    if (m_grabCursor) {
-        QImage ci;
-        QRect cr;
-        QPoint cp;
-        std::tie(ci, cr, cp) = grabMouseCursor(QRect(p, s), qimg);
-
-        QPainter p(&qimg);
-
-        if (m_drawMouseClick && m_isMouseButtonPressed) {
-            QRadialGradient gradient(cp, cr.width() / 2);
-            gradient.setColorAt(0, Qt::transparent);
-            gradient.setColorAt(1, Qt::yellow);
+    m_title->recordButton()->setEnabled(false);
+    m_title->settingsButton()->setEnabled(false);
 
-            p.setPen(Qt::NoPen);
-            p.setBrush(QBrush(gradient));
-            p.drawEllipse(cp.x() - cr.width() / 2, cp.y() - cr.width() / 2, cr.width(), cr.width());
-        }
+    const auto duplicates = m_capture->duplicateFrames();
 
-        p.drawImage(cr, ci, ci.rect());
+    if (duplicates > 0) {
+        m_title->msg()->setText(
+            tr("Writing GIF... Please wait. %n duplicate frame(s) merged.", "", static_cast<int>(duplicates)));
+    } else {
+        m_title->msg()->setText(tr("Writing GIF... Please wait."));
     }
 
-    if (m_grabKeys && !m_key.isEmpty()) {
-        QPainter p(&qimg);
-
-        const auto w = p.fontMetrics().horizontalAdvance(m_key);
-        static const int delta = 5;
+    m_busy = true;
 
-        p.setPen(Qt::black);
-        p.setBrush(Qt::white);
-        const auto r = QRect(qimg.width() - w - delta, delta, w, p.fontMetrics().height());
+    // Overlays are recorded aside, so current settings decide what is drawn.
+    m_capture->setOverlayOptions(overlayOptions());
 
-        p.drawRect(r.adjusted(-delta - 1, -delta + 1, delta - 1, delta + 1));
-        p.drawText(r, m_key);
-    }
-
-    m_frames.push_back(m_dir.filePath(QString("%1.png").arg(++m_counter)));
-    qimg.save(m_frames.back());
+    connect(&m_watcher, &QFutureWatcher<void>::finished, this, &MainWindow::onGIFSaved);
+    auto future = QtConcurrent::run(writeGIF, this, m_capture, fileName);
+    m_watcher.setFuture(future);
 }
 
-namespace /* anonymous */
-{
-
-void writeGIF(QPromise<bool> &promise,
-              MainWindow *progressReceiver,
-              const QStringList &frames,
-              const QVector<int> &delays,
-              const QString &fileName)
+OverlayOptions MainWindow::overlayOptions() const
 {
-    QGifLib::Gif gif;
-
-    QObject::connect(&gif, &QGifLib::Gif::writeProgress, progressReceiver, &MainWindow::onWritePercent);
+    OverlayOptions o;
+    o.m_cursor = m_grabCursor;
+    o.m_clicks = m_drawMouseClick;
+    o.m_keys = m_grabKeys;
 
-    if (!gif.write(fileName, frames, delays, 0, &promise)) {
-        int methodIndex = progressReceiver->metaObject()->indexOfMethod("onWritePercent(int)");
-        QMetaMethod method = progressReceiver->metaObject()->method(methodIndex);
-        method.invoke(progressReceiver, Qt::QueuedConnection, 100);
-    }
+    return o;
 }
 
-} /* namespase anonymous */
-
-void MainWindow::save(const QString &fileName)
+void MainWindow::onSaveReplay()
 {
-    m_title->recordButton()->setEnabled(false);
-    m_title->settingsButton()->setEnabled(false);
+    // Replay is saved while recording goes on, one at a time.
+    if (!m_recording || m_replaySeconds <= 0 || m_replayWatcher.isRunning()) {
+        return;
+    }
 
-    m_title->msg()->setText(tr("Writing GIF... Please wait."));
+    const auto dirs = QStandardPaths::standardLocations(QStandardPaths::PicturesLocation);
 
-    m_busy = true;
+    m_replayFile = QDir(dirs.first())
+                       .filePath(QStringLiteral("replay-%1.gif")
+                                     .arg(QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-hhmmss"))));
 
-    m_delays.removeFirst();
-    m_delays.push_back(0);
+    m_capture->setOverlayOptions(overlayOptions());
+    m_title->msg()->setText(tr("Saving replay..."));
 
-    connect(&m_watcher, &QFutureWatcher<void>::finished, this, &MainWindow::onGIFSaved);
-    auto future = QtConcurrent::run(writeGIF, this, m_frames, m_delays, fileName);
-    m_watcher.setFuture(future);
+    m_replayWatcher.setFuture(QtConcurrent::run([capture = m_capture, fileName = m_replayFile]() {
+        return capture->saveReplay(fileName);
+    }));
+}
+
+void MainWindow::onReplaySaved()
+{
+    if (m_replayWatcher.future().result()) {
+        m_title->msg()->setText(tr("Replay saved to %1").arg(QDir::toNativeSeparators(m_replayFile)));
+    } else {
+        m_title->msg()->setText(tr("Unable to save replay to %1").arg(QDir::toNativeSeparators(m_replayFile)));
+    }
 }
 
 void MainWindow::onGIFSaved()
 {
+    disconnect(&m_watcher, 0, this, 0);
+
     m_busy = false;
 
     m_title->recordButton()->setEnabled(true);
@@ -882,13 +821,46 @@ void MainWindow::onGIFSaved()
     clear();
 }
 
+void MainWindow::onStatsTimer()
+{
+    const auto stats = m_capture->stats();
+    const auto interval = stats.m_elapsed - m_lastStats.m_elapsed;
+
+    if (interval <= 0) {
+        return;
+    }
+
+    // Rate of the last interval, so a slowdown is seen at once.
+    const auto fps = (stats.m_captured - m_lastStats.m_captured) * 1000.0 / interval;
+    const auto dropped = stats.m_dropped - m_lastStats.m_dropped;
+    const auto backlog = stats.m_encoderBacklog + stats.m_packingBacklog;
+    const auto growing = (backlog > m_lastStats.m_encoderBacklog + m_lastStats.m_packingBacklog);
+
+    m_title->msg()->setText(tr("%1/%2 fps, %3 frames, %4 merged, %5 dropped, %6 MB + %7 MB on disk, backlog %8")
+                                .arg(fps, 0, 'f', 1)
+                                .arg(m_fps)
+                                .arg(stats.m_captured)
+                                .arg(stats.m_duplicates)
+                                .arg(stats.m_dropped)
+                                .arg(stats.m_memory / (1024 * 1024))
+                                .arg(stats.m_spilled / (1024 * 1024))
+                                .arg(backlog));
+
+    // Region is too large for the machine.
+    auto palette = m_title->palette();
+
+    if (dropped > 0 || (growing && backlog > m_fps)) {
+        palette.setColor(QPalette::WindowText, Qt::red);
+    }
+
+    m_title->msg()->setPalette(palette);
+
+    m_lastStats = stats;
+}
+
 void MainWindow::clear()
 {
-    m_frames.clear();
-    m_dir.remove();
-    m_counter = 0;
-    m_elapsed.invalidate();
-    m_delays.clear();
+    m_capture->clear();
 }
 
 void MainWindow::closeEvent(QCloseEvent *e)
@@ -904,7 +876,7 @@ void MainWindow::closeEvent(QCloseEvent *e)
         }
 
         e->ignore();
-    } else if (m_skipQuitEvent) {
+    } else if (m_skipQuitEvent || m_replayWatcher.isRunning()) {
         e->ignore();
     } else {
         e->accept();
@@ -8,16 +8,17 @@
 // Qt include.
 #include <QAbstractButton>
 #include <QBitmap>
-#include <QElapsedTimer>
 #include <QFrame>
 #include <QFutureWatcher>
 #include <QLabel>
 #include <QProgressBar>
-#include <QTemporaryDir>
 #include <QTimer>
 #include <QToolButton>
 #include <QWidget>
 
+// GIF recorder include.
+#include "capture.hpp"
+
 class CloseButton;
 class MainWindow;
 
@@ -161,21 +162,25 @@ protected:
 private slots:
     void onSettings();
     void onRecord();
-    void onTimer();
-    void onMousePressed();
-    void onMouseReleased();
-    void onKeyPressed(const QString &key);
-    void onKeyReleased(const QString &key);
     void onResizeRequested();
     void onTransparentForMouse(bool checked);
     void onGIFSaved();
+    void onStatsTimer();
+    void onSaveReplay();
+    void onReplaySaved();
+    void onProjectShared();
 #if defined(Q_OS_WIN) && defined(MD_BREEZE)
     void onChangeTheme();
 #endif
 
 private:
-    void makeFrame();
     void save(const QString &fileName);
+    //! \return Path of GIF editor, empty if it's not found or frames can't be passed to it.
+    static QString editorExecutable();
+    //! Pass recorded frames to GIF editor through shared memory and start it.
+    void openInEditor(const QString &editor);
+    //! \return Overlays drawn on saving.
+    OverlayOptions overlayOptions() const;
     Orientation orientationUnder(const QPoint &p) const;
     void makeAndSetMask();
     void drawRect(QPainter *p,
@@ -188,23 +193,24 @@ private:
     Q_DISABLE_COPY(MainWindow)
 
     TitleWidget *m_title = nullptr;
-    QTimer *m_timer = nullptr;
-    QTimer *m_keysTimer = nullptr;
+    Capture *m_capture = nullptr;
+    InputEvents *m_events = nullptr;
+    QTimer *m_statsTimer = nullptr;
+    CaptureStats m_lastStats;
     int m_fps = 24;
+    bool m_adaptiveFps = false;
     bool m_grabCursor = true;
     bool m_grabKeys = false;
+    int m_memoryBudget = 512;
+    bool m_showStats = false;
+    int m_downscale = 1;
+    int m_replaySeconds = 0;
+    PaletteMode m_paletteMode = PaletteMode::Stable;
     bool m_drawMouseClick = true;
     bool m_recording = false;
     bool m_busy = false;
-    bool m_isMouseButtonPressed = false;
     bool m_skipQuitEvent = false;
     bool m_isMouseDisabledByUser = false;
-    QTemporaryDir m_dir;
-    QStringList m_frames;
-    QString m_key;
-    qsizetype m_counter = 0;
-    QElapsedTimer m_elapsed;
-    QVector<int> m_delays;
     QRect m_rect;
     Orientation m_current = Unknown;
     Orientation m_cursor = Unknown;
@@ -219,4 +225,10 @@ private:
     QRegion m_bottomRight;
     QColor m_color;
     QFutureWatcher<bool> m_watcher;
+    QFutureWatcher<bool> m_replayWatcher;
+    QString m_replayFile;
+    //! Path of GIF editor frames are passed to.
+    QString m_editor;
+    //! Name of the shared memory segment with frames for GIF editor.
+    QString m_sharedProject;
 }; // class MainWindow
@@ -0,0 +1,84 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QtGlobal>
+
+// C++ include.
+#include <atomic>
+#include <utility>
+
+//
+// MpscQueue
+//
+
+//! Lock-free unbounded FIFO for many producers and one consumer.
+//! Producers never wait for each other, consumer may see the queue empty
+//! for a moment while a producer is in the middle of push().
+template<class T>
+class MpscQueue final
+{
+public:
+    MpscQueue()
+        : m_head(new Node)
+        , m_tail(m_head.load())
+    {
+    }
+
+    ~MpscQueue()
+    {
+        T value;
+
+        while (pop(value)) {
+        }
+
+        delete m_tail;
+    }
+
+    //! Push value. May be called from any thread.
+    void push(T value)
+    {
+        auto node = new Node;
+        node->m_value = std::move(value);
+
+        auto prev = m_head.exchange(node, std::memory_order_acq_rel);
+        prev->m_next.store(node, std::memory_order_release);
+    }
+
+    //! Pop value. Should be called from one thread at a time. \return false if queue is empty.
+    bool pop(T &value)
+    {
+        auto next = m_tail->m_next.load(std::memory_order_acquire);
+
+        if (!next) {
+            return false;
+        }
+
+        value = std::move(next->m_value);
+
+        delete m_tail;
+        m_tail = next;
+
+        return true;
+    }
+
+private:
+    Q_DISABLE_COPY(MpscQueue)
+
+    //! Node of the queue.
+    struct Node {
+        //! Next node.
+        std::atomic<Node *> m_next{nullptr};
+        //! Value.
+        T m_value;
+    }; // struct Node
+
+    //! Last pushed node, producers side.
+    std::atomic<Node *> m_head;
+    //! Stub node before the first value, consumer side.
+    Node *m_tail;
+}; // class MpscQueue
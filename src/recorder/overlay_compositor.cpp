@@ -0,0 +1,252 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF recorder include.
+#include "overlay_compositor.hpp"
+
+// Qt include.
+#include <QFontMetrics>
+#include <QPainter>
+#include <QRadialGradient>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace /* anonymous */
+{
+
+//! Gap between the key label and the edges of the frame.
+const int s_keyDelta = 5;
+//! Maximum count of cached sprites of one kind, cache is dropped when it's exceeded.
+const int s_maxSprites = 64;
+
+//! \return \a v / 255 rounded, \a v is a product of two bytes.
+inline quint32 div255(quint32 v)
+{
+    v += 128;
+
+    return (v + (v >> 8)) >> 8;
+}
+
+//! Blend \a count premultiplied pixels of \a src onto opaque \a dst.
+void blendLine(const quint32 *src,
+               quint32 *dst,
+               int count)
+{
+    int x = 0;
+
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi32(255);
+    const __m128i half = _mm_set1_epi16(128);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xff000000u));
+
+    for (; x + 4 <= count; x += 4) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x));
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + x));
+
+        // 255 - alpha of every source pixel in both halves of its 32 bits.
+        __m128i ia = _mm_sub_epi32(full, _mm_srli_epi32(s, 24));
+        ia = _mm_or_si128(ia, _mm_slli_epi32(ia, 16));
+
+        __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi32(ia, ia));
+        __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi32(ia, ia));
+
+        lo = _mm_add_epi16(lo, half);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_add_epi16(hi, half);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+
+        const __m128i r = _mm_adds_epu8(s, _mm_packus_epi16(lo, hi));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), _mm_or_si128(r, alpha));
+    }
+#elif defined(__ARM_NEON)
+    for (; x + 8 <= count; x += 8) {
+        const uint8x8x4_t s = vld4_u8(reinterpret_cast<const uint8_t *>(src + x));
+        uint8x8x4_t d = vld4_u8(reinterpret_cast<const uint8_t *>(dst + x));
+        const uint8x8_t ia = vmvn_u8(s.val[3]);
+
+        for (int c = 0; c < 3; ++c) {
+            const uint16x8_t m = vmull_u8(d.val[c], ia);
+            d.val[c] = vqadd_u8(s.val[c], vrshrn_n_u16(vrsraq_n_u16(m, m, 8), 8));
+        }
+
+        d.val[3] = vdup_n_u8(255);
+        vst4_u8(reinterpret_cast<uint8_t *>(dst + x), d);
+    }
+#endif
+
+    for (; x < count; ++x) {
+        const auto s = src[x];
+        const auto ia = 255 - (s >> 24);
+        const auto d = dst[x];
+
+        const auto b = qMin<quint32>(255, (s & 0xff) + div255((d & 0xff) * ia));
+        const auto g = qMin<quint32>(255, ((s >> 8) & 0xff) + div255(((d >> 8) & 0xff) * ia));
+        const auto r = qMin<quint32>(255, ((s >> 16) & 0xff) + div255(((d >> 16) & 0xff) * ia));
+
+        dst[x] = 0xff000000u | (r << 16) | (g << 8) | b;
+    }
+}
+
+} /* namespace anonymous */
+
+//
+// OverlayCompositor
+//
+
+Overlays OverlayCompositor::layout(const MouseCursor &cursor,
+                                   bool click,
+                                   const QString &key,
+                                   const QSize &frameSize)
+{
+    Overlays o;
+    o.m_cursor = cursor;
+    o.m_rect = cursor.m_rect;
+
+    if (!cursor.m_image.isNull()) {
+        o.m_cursor.m_image = cursorSprite(cursor);
+    }
+
+    if (click && cursor.m_rect.width() > 0) {
+        const auto size = cursor.m_rect.width();
+
+        o.m_halo = halo(size);
+        o.m_haloPos = cursor.m_hotSpot - QPoint(size / 2, size / 2);
+        o.m_rect |= QRect(o.m_haloPos, o.m_halo.size());
+    }
+
+    if (!key.isEmpty()) {
+        o.m_label = label(key);
+        o.m_labelPos = QPoint(frameSize.width() - o.m_label.width(), 1);
+        o.m_rect |= QRect(o.m_labelPos, o.m_label.size());
+    }
+
+    return o;
+}
+
+void OverlayCompositor::draw(QImage &img,
+                             const Overlays &o,
+                             const QPoint &origin) const
+{
+    if (!o.m_halo.isNull()) {
+        blend(img, o.m_halo, o.m_haloPos - origin);
+    }
+
+    if (!o.m_cursor.m_image.isNull()) {
+        blend(img, o.m_cursor.m_image, o.m_cursor.m_rect.topLeft() - origin);
+    }
+
+    if (!o.m_label.isNull()) {
+        blend(img, o.m_label, o.m_labelPos - origin);
+    }
+}
+
+void OverlayCompositor::blend(QImage &img,
+                              const QImage &sprite,
+                              const QPoint &pos)
+{
+    const auto r = QRect(pos, sprite.size()) & img.rect();
+
+    for (int y = r.top(); y <= r.bottom(); ++y) {
+        blendLine(reinterpret_cast<const quint32 *>(sprite.constScanLine(y - pos.y())) + (r.x() - pos.x()),
+                  reinterpret_cast<quint32 *>(img.scanLine(y)) + r.x(),
+                  r.width());
+    }
+}
+
+const QImage &OverlayCompositor::halo(int size)
+{
+    auto it = m_halos.find(size);
+
+    if (it != m_halos.end()) {
+        return *it;
+    }
+
+    if (m_halos.size() >= s_maxSprites) {
+        m_halos.clear();
+    }
+
+    QImage sprite(size, size, QImage::Format_ARGB32_Premultiplied);
+    sprite.fill(Qt::transparent);
+
+    {
+        const auto radius = size / 2;
+
+        QRadialGradient gradient(QPoint(radius, radius), radius);
+        gradient.setColorAt(0, Qt::transparent);
+        gradient.setColorAt(1, Qt::yellow);
+
+        QPainter p(&sprite);
+        p.setPen(Qt::NoPen);
+        p.setBrush(QBrush(gradient));
+        p.drawEllipse(0, 0, size, size);
+    }
+
+    return *m_halos.insert(size, sprite);
+}
+
+const QImage &OverlayCompositor::label(const QString &key)
+{
+    auto it = m_labels.find(key);
+
+    if (it != m_labels.end()) {
+        return *it;
+    }
+
+    if (m_labels.size() >= s_maxSprites) {
+        m_labels.clear();
+    }
+
+    // Metrics of the image, as text is drawn on the image.
+    QImage sprite(1, 1, QImage::Format_ARGB32_Premultiplied);
+    const QFontMetrics fm(QFont(), &sprite);
+    const auto w = fm.horizontalAdvance(key);
+    const auto h = fm.height();
+
+    sprite = QImage(w + s_keyDelta * 2 + 1, h + s_keyDelta * 2 + 1, QImage::Format_ARGB32_Premultiplied);
+    sprite.fill(Qt::transparent);
+
+    {
+        QPainter p(&sprite);
+        p.setPen(Qt::black);
+        p.setBrush(Qt::white);
+        p.drawRect(0, 0, w + s_keyDelta * 2, h + s_keyDelta * 2);
+        p.drawText(QRect(s_keyDelta + 1, s_keyDelta - 1, w, h), key);
+    }
+
+    return *m_labels.insert(key, sprite);
+}
+
+QImage OverlayCompositor::cursorSprite(const MouseCursor &cursor)
+{
+    if (cursor.m_serial) {
+        const auto it = m_cursors.constFind(cursor.m_serial);
+
+        if (it != m_cursors.cend()) {
+            return *it;
+        }
+    }
+
+    const auto sprite = (cursor.m_image.format() == QImage::Format_ARGB32_Premultiplied
+                             ? cursor.m_image
+                             : cursor.m_image.convertToFormat(QImage::Format_ARGB32_Premultiplied));
+
+    // Without serial the cursor can't be recognized later, so it's not cached.
+    if (cursor.m_serial) {
+        if (m_cursors.size() >= s_maxSprites) {
+            m_cursors.clear();
+        }
+
+        m_cursors.insert(cursor.m_serial, sprite);
+    }
+
+    return sprite;
+}
@@ -0,0 +1,81 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// GIF recorder include.
+#include "cursor_tracker.hpp"
+
+// Qt include.
+#include <QHash>
+#include <QImage>
+#include <QPoint>
+#include <QRect>
+#include <QString>
+
+//
+// Overlays
+//
+
+//! Overlays to draw on the frame. Sprites are premultiplied and implicitly shared with the cache.
+struct Overlays {
+    //! Mouse cursor.
+    MouseCursor m_cursor;
+    //! Sprite of the click around the cursor, null if there is no click.
+    QImage m_halo;
+    //! Position of the click sprite.
+    QPoint m_haloPos;
+    //! Sprite of the key label, null if there is no key.
+    QImage m_label;
+    //! Position of the key label.
+    QPoint m_labelPos;
+    //! Bounding rect of all overlays.
+    QRect m_rect;
+}; // struct Overlays
+
+//
+// OverlayCompositor
+//
+
+//! Compositor of overlays. Sprites of clicks, key labels and cursors are
+//! rasterised once and then only blended onto frames. Should be used in one thread.
+class OverlayCompositor final
+{
+public:
+    OverlayCompositor() = default;
+
+    //! \return Overlays for the frame of \a frameSize with \a cursor, click if \a click
+    //! and \a key label if it's not empty.
+    Overlays layout(const MouseCursor &cursor,
+                    bool click,
+                    const QString &key,
+                    const QSize &frameSize);
+    //! Blend overlays onto the 32 bits per pixel \a img, which is the part of the frame at \a origin.
+    void draw(QImage &img,
+              const Overlays &o,
+              const QPoint &origin = {}) const;
+
+    //! Blend premultiplied \a sprite onto the opaque 32 bits per pixel \a img at \a pos.
+    static void blend(QImage &img,
+                      const QImage &sprite,
+                      const QPoint &pos);
+
+private:
+    Q_DISABLE_COPY(OverlayCompositor)
+
+    //! \return Sprite of the click for the cursor of the given width.
+    const QImage &halo(int size);
+    //! \return Sprite of the label of the key.
+    const QImage &label(const QString &key);
+    //! \return Premultiplied sprite of the cursor.
+    QImage cursorSprite(const MouseCursor &cursor);
+
+    //! Click sprites by cursor width.
+    QHash<int, QImage> m_halos;
+    //! Key labels by text.
+    QHash<QString, QImage> m_labels;
+    //! Cursor sprites by serial.
+    QHash<unsigned long, QImage> m_cursors;
+}; // class OverlayCompositor
@@ -0,0 +1,154 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF recorder include.
+#include "overlay_track.hpp"
+
+// Qt include.
+#include <QMutexLocker>
+
+// C++ include.
+#include <algorithm>
+
+//
+// OverlayTrack
+//
+
+QSize OverlayTrack::frameSize() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return m_frameSize;
+}
+
+void OverlayTrack::setFrameSize(const QSize &s)
+{
+    QMutexLocker lock(&m_mutex);
+
+    m_frameSize = s;
+}
+
+void OverlayTrack::append(const OverlaySample &s)
+{
+    QMutexLocker lock(&m_mutex);
+
+    m_samples.push_back(s);
+}
+
+qsizetype OverlayTrack::count() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return m_samples.size();
+}
+
+OverlaySample OverlayTrack::at(qsizetype idx) const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return m_samples.value(idx);
+}
+
+void OverlayTrack::addCursor(quint64 id,
+                             const QImage &sprite)
+{
+    QMutexLocker lock(&m_mutex);
+
+    m_cursors.insert(id, sprite);
+}
+
+QImage OverlayTrack::cursor(quint64 id) const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return m_cursors.value(id);
+}
+
+void OverlayTrack::addKey(quint32 key,
+                          const QString &name)
+{
+    QMutexLocker lock(&m_mutex);
+
+    m_keys.insert(key, name);
+}
+
+QString OverlayTrack::keyName(quint32 key) const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return m_keys.value(key);
+}
+
+QHash<quint32, QString> OverlayTrack::keyNames() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return m_keys;
+}
+
+void OverlayTrack::copySprites(const OverlayTrack &other)
+{
+    if (&other == this) {
+        return;
+    }
+
+    QSize frameSize;
+    QHash<quint64, QImage> cursors;
+    QHash<quint32, QString> keys;
+
+    {
+        QMutexLocker lock(&other.m_mutex);
+
+        frameSize = other.m_frameSize;
+        cursors = other.m_cursors;
+        keys = other.m_keys;
+    }
+
+    QMutexLocker lock(&m_mutex);
+
+    m_frameSize = frameSize;
+    m_cursors = cursors;
+    m_keys = keys;
+}
+
+void OverlayTrack::appendEvent(const InputEvent &e)
+{
+    QMutexLocker lock(&m_mutex);
+
+    m_events.push_back(e);
+}
+
+QVector<InputEvent> OverlayTrack::events() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return m_events;
+}
+
+void OverlayTrack::removeEventsBefore(qint64 timestamp)
+{
+    QMutexLocker lock(&m_mutex);
+
+    // Events are appended in order of time.
+    const auto it = std::lower_bound(m_events.cbegin(),
+                                     m_events.cend(),
+                                     timestamp,
+                                     [](const InputEvent &e, qint64 t) {
+                                         return e.m_timestamp < t;
+                                     });
+
+    m_events.erase(m_events.cbegin(), it);
+}
+
+void OverlayTrack::clear()
+{
+    QMutexLocker lock(&m_mutex);
+
+    m_frameSize = {};
+    m_samples.clear();
+    m_cursors.clear();
+    m_keys.clear();
+    m_events.clear();
+}
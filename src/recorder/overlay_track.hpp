@@ -0,0 +1,139 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QPoint>
+#include <QRect>
+#include <QString>
+#include <QVector>
+
+// GIF recorder include.
+#include "input_events.hpp"
+
+//
+// OverlayOptions
+//
+
+//! Which overlays are drawn on frames.
+struct OverlayOptions {
+    //! Draw mouse cursor.
+    bool m_cursor = true;
+    //! Draw mouse clicks.
+    bool m_clicks = true;
+    //! Draw keyboard keys presses.
+    bool m_keys = false;
+
+    bool operator==(const OverlayOptions &other) const
+    {
+        return m_cursor == other.m_cursor && m_clicks == other.m_clicks && m_keys == other.m_keys;
+    }
+
+    bool operator!=(const OverlayOptions &other) const
+    {
+        return !(*this == other);
+    }
+}; // struct OverlayOptions
+
+//
+// OverlaySample
+//
+
+//! State of overlays on the frame.
+struct OverlaySample {
+    //! Rect of the cursor sprite, empty if cursor is out of the grab area.
+    QRect m_cursorRect;
+    //! Hot spot of the cursor.
+    QPoint m_hotSpot = {-1, -1};
+    //! Id of the cursor sprite, 0 if there is no sprite.
+    quint64 m_cursor = 0;
+    //! Key, 0 if there is no key.
+    quint32 m_key = 0;
+    //! Is mouse button pressed.
+    bool m_click = false;
+
+    bool operator==(const OverlaySample &other) const
+    {
+        return m_cursorRect == other.m_cursorRect && m_hotSpot == other.m_hotSpot && m_cursor == other.m_cursor
+            && m_key == other.m_key && m_click == other.m_click;
+    }
+
+    bool operator!=(const OverlaySample &other) const
+    {
+        return !(*this == other);
+    }
+}; // struct OverlaySample
+
+//
+// OverlayTrack
+//
+
+//! Side track of recorded frames: cursor and input state of every frame, sprites of
+//! cursors, names of keys and timeline of input events. Frames themselves are clean,
+//! overlays are drawn when GIF is encoded. May be read in one thread while it's written in another.
+class OverlayTrack final
+{
+public:
+    OverlayTrack() = default;
+
+    //! \return Size of the whole frame.
+    QSize frameSize() const;
+    //! Set size of the whole frame.
+    void setFrameSize(const QSize &s);
+
+    //! Append state of the next frame.
+    void append(const OverlaySample &s);
+    //! \return Count of samples.
+    qsizetype count() const;
+    //! \return Sample of the frame at the given index.
+    OverlaySample at(qsizetype idx) const;
+
+    //! Remember sprite of the cursor with the given id.
+    void addCursor(quint64 id,
+                   const QImage &sprite);
+    //! \return Sprite of the cursor.
+    QImage cursor(quint64 id) const;
+
+    //! Remember name of the key.
+    void addKey(quint32 key,
+                const QString &name);
+    //! \return Name of the key.
+    QString keyName(quint32 key) const;
+    //! \return Names of all keys.
+    QHash<quint32, QString> keyNames() const;
+
+    //! Take size of the frame, sprites of cursors and names of keys from \a other. Samples and events stay.
+    void copySprites(const OverlayTrack &other);
+
+    //! Append input event, its timestamp is in milliseconds since start of recording.
+    void appendEvent(const InputEvent &e);
+    //! \return Input events.
+    QVector<InputEvent> events() const;
+    //! Remove input events older than \a timestamp.
+    void removeEventsBefore(qint64 timestamp);
+
+    //! Remove everything.
+    void clear();
+
+private:
+    Q_DISABLE_COPY(OverlayTrack)
+
+    //! Guard.
+    mutable QMutex m_mutex;
+    //! Size of the whole frame.
+    QSize m_frameSize;
+    //! Samples of frames.
+    QVector<OverlaySample> m_samples;
+    //! Sprites of cursors.
+    QHash<quint64, QImage> m_cursors;
+    //! Names of keys.
+    QHash<quint32, QString> m_keys;
+    //! Input events.
+    QVector<InputEvent> m_events;
+}; // class OverlayTrack
@@ -0,0 +1,351 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF recorder include.
+#include "palette.hpp"
+
+// C++ include.
+#include <algorithm>
+#include <limits>
+
+//
+// Histogram
+//
+
+Histogram::Histogram()
+    : m_count(s_size, 0)
+    , m_red(s_size, 0)
+    , m_green(s_size, 0)
+    , m_blue(s_size, 0)
+{
+}
+
+void Histogram::add(const QImage &img,
+                    const QRect &r)
+{
+    const auto rect = (r.isNull() ? img.rect() : r.intersected(img.rect()));
+
+    for (int y = rect.y(); y <= rect.bottom(); ++y) {
+        const auto line = reinterpret_cast<const QRgb *>(img.constScanLine(y));
+
+        for (int x = rect.x(); x <= rect.right(); ++x) {
+            const auto c = line[x];
+            const auto k = static_cast<size_t>(key(c));
+
+            ++m_count[k];
+            m_red[k] += static_cast<quint64>(qRed(c));
+            m_green[k] += static_cast<quint64>(qGreen(c));
+            m_blue[k] += static_cast<quint64>(qBlue(c));
+        }
+    }
+
+    m_total += static_cast<quint64>(rect.width()) * static_cast<quint64>(rect.height());
+}
+
+void Histogram::add(const Histogram &other)
+{
+    for (size_t k = 0; k < static_cast<size_t>(s_size); ++k) {
+        m_count[k] += other.m_count[k];
+        m_red[k] += other.m_red[k];
+        m_green[k] += other.m_green[k];
+        m_blue[k] += other.m_blue[k];
+    }
+
+    m_total += other.m_total;
+}
+
+void Histogram::decay()
+{
+    m_total = 0;
+
+    for (size_t k = 0; k < static_cast<size_t>(s_size); ++k) {
+        m_count[k] -= m_count[k] >> 3;
+        m_red[k] -= m_red[k] >> 3;
+        m_green[k] -= m_green[k] >> 3;
+        m_blue[k] -= m_blue[k] >> 3;
+        m_total += m_count[k];
+    }
+}
+
+void Histogram::clear()
+{
+    std::fill(m_count.begin(), m_count.end(), 0);
+    std::fill(m_red.begin(), m_red.end(), 0);
+    std::fill(m_green.begin(), m_green.end(), 0);
+    std::fill(m_blue.begin(), m_blue.end(), 0);
+    m_total = 0;
+}
+
+bool Histogram::isEmpty() const
+{
+    return (m_total == 0);
+}
+
+namespace /* anonymous */
+{
+
+//! The biggest mean squared distance of pixels to the palette that is still covered by it.
+const quint64 s_maxMeanError = 3 * 8 * 8;
+//! Squared distance to the palette of the pixel that doesn't fit the palette.
+const int s_farError = 3 * 32 * 32;
+//! Part of pixels that may not fit the palette, 1/256.
+const int s_farShift = 8;
+
+//! Occupied cell of the histogram.
+struct Cell {
+    //! Key of the cell.
+    int m_key = 0;
+    //! Count of pixels.
+    quint64 m_count = 0;
+    //! Average color components.
+    int m_rgb[3] = {0, 0, 0};
+}; // struct Cell
+
+//! Box of the median cut, range of cells.
+struct Box {
+    //! First cell.
+    size_t m_begin = 0;
+    //! Last cell + 1.
+    size_t m_end = 0;
+    //! Count of pixels.
+    quint64 m_count = 0;
+    //! Channel with the longest range.
+    int m_channel = 0;
+    //! Longest range.
+    int m_range = 0;
+}; // struct Box
+
+void shrink(Box &b,
+            const std::vector<Cell> &cells)
+{
+    int minC[3] = {255, 255, 255};
+    int maxC[3] = {0, 0, 0};
+    b.m_count = 0;
+
+    for (auto i = b.m_begin; i < b.m_end; ++i) {
+        const auto &c = cells[i];
+        b.m_count += c.m_count;
+
+        for (int ch = 0; ch < 3; ++ch) {
+            minC[ch] = qMin(minC[ch], c.m_rgb[ch]);
+            maxC[ch] = qMax(maxC[ch], c.m_rgb[ch]);
+        }
+    }
+
+    b.m_channel = 0;
+    b.m_range = maxC[0] - minC[0];
+
+    for (int ch = 1; ch < 3; ++ch) {
+        if (maxC[ch] - minC[ch] > b.m_range) {
+            b.m_range = maxC[ch] - minC[ch];
+            b.m_channel = ch;
+        }
+    }
+}
+
+} /* namespace anonymous */
+
+//
+// Palette
+//
+
+Palette::Palette()
+    : m_lookup(Histogram::s_size, -1)
+{
+}
+
+Palette Palette::build(const Histogram &h,
+                       int maxColors)
+{
+    Palette p;
+
+    std::vector<Cell> cells;
+
+    for (int k = 0; k < Histogram::s_size; ++k) {
+        const auto count = h.m_count[static_cast<size_t>(k)];
+
+        if (count) {
+            Cell c;
+            c.m_key = k;
+            c.m_count = count;
+            c.m_rgb[0] = static_cast<int>(h.m_red[static_cast<size_t>(k)] / count);
+            c.m_rgb[1] = static_cast<int>(h.m_green[static_cast<size_t>(k)] / count);
+            c.m_rgb[2] = static_cast<int>(h.m_blue[static_cast<size_t>(k)] / count);
+            cells.push_back(c);
+        }
+    }
+
+    if (cells.empty()) {
+        return p;
+    }
+
+    std::vector<Box> boxes;
+    Box first;
+    first.m_end = cells.size();
+    shrink(first, cells);
+    boxes.push_back(first);
+
+    while (boxes.size() < static_cast<size_t>(maxColors)) {
+        // Split the box where the most pixels are spread over the longest range.
+        size_t toSplit = boxes.size();
+        double best = 0.0;
+
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            const auto &b = boxes[i];
+
+            if (b.m_end - b.m_begin > 1) {
+                const auto score = static_cast<double>(b.m_range) * static_cast<double>(b.m_count);
+
+                if (toSplit == boxes.size() || score > best) {
+                    best = score;
+                    toSplit = i;
+                }
+            }
+        }
+
+        if (toSplit == boxes.size()) {
+            break;
+        }
+
+        auto &b = boxes[toSplit];
+        const auto ch = b.m_channel;
+
+        std::sort(cells.begin() + static_cast<std::ptrdiff_t>(b.m_begin),
+                  cells.begin() + static_cast<std::ptrdiff_t>(b.m_end),
+                  [ch](const Cell &c1, const Cell &c2) {
+                      return c1.m_rgb[ch] < c2.m_rgb[ch];
+                  });
+
+        const auto half = b.m_count / 2;
+        auto median = b.m_begin;
+        quint64 sum = cells[median].m_count;
+
+        // Both halves should have at least one cell.
+        while (sum < half && median + 2 < b.m_end) {
+            ++median;
+            sum += cells[median].m_count;
+        }
+
+        Box second;
+        second.m_begin = median + 1;
+        second.m_end = b.m_end;
+        b.m_end = median + 1;
+
+        shrink(b, cells);
+        shrink(second, cells);
+        boxes.push_back(second);
+    }
+
+    p.m_colors.reserve(static_cast<qsizetype>(boxes.size()));
+
+    for (const auto &b : boxes) {
+        quint64 rgb[3] = {0, 0, 0};
+
+        for (auto i = b.m_begin; i < b.m_end; ++i) {
+            const auto &c = cells[i];
+
+            for (int ch = 0; ch < 3; ++ch) {
+                rgb[ch] += static_cast<quint64>(c.m_rgb[ch]) * c.m_count;
+            }
+
+            p.m_lookup[static_cast<size_t>(c.m_key)] = static_cast<qint16>(p.m_colors.size());
+        }
+
+        p.m_colors.push_back(qRgb(static_cast<int>(rgb[0] / b.m_count),
+                                  static_cast<int>(rgb[1] / b.m_count),
+                                  static_cast<int>(rgb[2] / b.m_count)));
+    }
+
+    return p;
+}
+
+const QVector<QRgb> &Palette::colors() const
+{
+    return m_colors;
+}
+
+bool Palette::isEmpty() const
+{
+    return m_colors.isEmpty();
+}
+
+bool Palette::covers(const Histogram &h) const
+{
+    if (m_colors.isEmpty() || h.isEmpty()) {
+        return false;
+    }
+
+    quint64 error = 0;
+    quint64 far = 0;
+
+    for (int k = 0; k < Histogram::s_size; ++k) {
+        const auto count = h.m_count[static_cast<size_t>(k)];
+
+        if (!count) {
+            continue;
+        }
+
+        const auto r = static_cast<int>(h.m_red[static_cast<size_t>(k)] / count);
+        const auto g = static_cast<int>(h.m_green[static_cast<size_t>(k)] / count);
+        const auto b = static_cast<int>(h.m_blue[static_cast<size_t>(k)] / count);
+        const auto c = m_colors.at(index(qRgb(r, g, b)));
+        const auto dr = qRed(c) - r;
+        const auto dg = qGreen(c) - g;
+        const auto db = qBlue(c) - b;
+        const auto d = dr * dr + dg * dg + db * db;
+
+        error += static_cast<quint64>(d) * count;
+
+        if (d > s_farError) {
+            far += count;
+        }
+    }
+
+    return (error <= s_maxMeanError * h.m_total && far <= (h.m_total >> s_farShift));
+}
+
+void Palette::map(const QImage &img,
+                  const QRect &r,
+                  uchar *indices) const
+{
+    for (int y = r.y(); y <= r.bottom(); ++y) {
+        const auto line = reinterpret_cast<const QRgb *>(img.constScanLine(y));
+
+        for (int x = r.x(); x <= r.right(); ++x) {
+            *indices++ = index(line[x]);
+        }
+    }
+}
+
+uchar Palette::nearest(int key) const
+{
+    if (m_colors.isEmpty()) {
+        return 0;
+    }
+
+    const int r = (((key >> 10) & 0x1F) << 3) | 0x04;
+    const int g = (((key >> 5) & 0x1F) << 3) | 0x04;
+    const int b = ((key & 0x1F) << 3) | 0x04;
+
+    int best = std::numeric_limits<int>::max();
+    qsizetype idx = 0;
+
+    for (qsizetype i = 0; i < m_colors.size(); ++i) {
+        const auto c = m_colors.at(i);
+        const auto dr = qRed(c) - r;
+        const auto dg = qGreen(c) - g;
+        const auto db = qBlue(c) - b;
+        const auto d = dr * dr + dg * dg + db * db;
+
+        if (d < best) {
+            best = d;
+            idx = i;
+        }
+    }
+
+    m_lookup[static_cast<size_t>(key)] = static_cast<qint16>(idx);
+
+    return static_cast<uchar>(idx);
+}
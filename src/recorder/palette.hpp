@@ -0,0 +1,107 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QImage>
+#include <QVector>
+
+// C++ include.
+#include <vector>
+
+//
+// Histogram
+//
+
+//! Color histogram with 5 bits per channel.
+class Histogram final
+{
+public:
+    Histogram();
+    ~Histogram() = default;
+
+    //! Count of cells in the histogram.
+    static constexpr int s_size = 32 * 32 * 32;
+
+    //! \return Cell of the color.
+    static inline int key(QRgb c)
+    {
+        return ((qRed(c) >> 3) << 10) | ((qGreen(c) >> 3) << 5) | (qBlue(c) >> 3);
+    }
+
+    //! Add pixels of the image in the rect.
+    void add(const QImage &img,
+             const QRect &r = {});
+    //! Add pixels of other histogram.
+    void add(const Histogram &other);
+    //! Reduce weight of pixels added so far by 1/8, so the histogram keeps the last frames.
+    void decay();
+    //! Clear histogram.
+    void clear();
+    //! \return Is there no pixels in the histogram.
+    bool isEmpty() const;
+
+private:
+    friend class Palette;
+
+    //! Count of pixels in cells.
+    std::vector<quint64> m_count;
+    //! Sums of red components in cells.
+    std::vector<quint64> m_red;
+    //! Sums of green components in cells.
+    std::vector<quint64> m_green;
+    //! Sums of blue components in cells.
+    std::vector<quint64> m_blue;
+    //! Total count of pixels.
+    quint64 m_total = 0;
+}; // class Histogram
+
+//
+// Palette
+//
+
+//! Palette of at most 256 colors with the fast lookup of the nearest color.
+class Palette final
+{
+public:
+    Palette();
+    ~Palette() = default;
+
+    //! Build palette with median cut of the histogram.
+    static Palette build(const Histogram &h,
+                         int maxColors = 256);
+
+    //! \return Colors.
+    const QVector<QRgb> &colors() const;
+    //! \return Is palette empty.
+    bool isEmpty() const;
+    //! \return Are colors of the histogram close enough to colors of the palette,
+    //! i.e. pixels of the histogram may be mapped to the palette without visible loss.
+    bool covers(const Histogram &h) const;
+
+    //! \return Index of the nearest to \a c color.
+    inline uchar index(QRgb c) const
+    {
+        const auto k = Histogram::key(c);
+        const auto i = m_lookup[static_cast<size_t>(k)];
+
+        return (i >= 0 ? static_cast<uchar>(i) : nearest(k));
+    }
+
+    //! Map pixels of the image in the rect to indices, row after row.
+    void map(const QImage &img,
+             const QRect &r,
+             uchar *indices) const;
+
+private:
+    //! Find, cache and return index of the nearest color for the cell.
+    uchar nearest(int key) const;
+
+    //! Colors.
+    QVector<QRgb> m_colors;
+    //! Indices of colors for histogram cells, -1 if not yet known.
+    mutable std::vector<qint16> m_lookup;
+}; // class Palette
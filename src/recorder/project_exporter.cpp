@@ -0,0 +1,128 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF recorder include.
+#include "project_exporter.hpp"
+#include "frame_composer.hpp"
+
+// shared include.
+#include "qoi.hpp"
+
+// Qt include.
+#include <QPainter>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+// C++ include.
+#include <deque>
+
+//
+// ProjectExporter
+//
+
+ProjectExporter::ProjectExporter(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void ProjectExporter::setShared(bool on)
+{
+    m_shared = on;
+}
+
+bool ProjectExporter::write(const QString &fileName,
+                            FrameComposer &frames,
+                            const QVector<int> &delays,
+                            const QVector<ProjectEvent> &events,
+                            const QHash<quint32, QString> &keyNames,
+                            QPromise<bool> *promise)
+{
+    auto finish = [promise](bool ok) {
+        if (promise) {
+            promise->addResult(ok);
+        }
+
+        return ok;
+    };
+
+    const auto count = frames.count();
+
+    ProjectWriter writer;
+
+    if (count == 0) {
+        return finish(false);
+    }
+
+    const auto opened =
+        (m_shared ? writer.openShared(fileName, frames.size(0)) : writer.open(fileName, frames.size(0)));
+
+    if (!opened) {
+        return finish(false);
+    }
+
+    emit writeProgress(0);
+
+    QImage canvas(frames.size(0), QImage::Format_RGB32);
+    canvas.fill(Qt::black);
+
+    // Whole frames are compressed in parallel, they are written in order.
+    QThreadPool pool;
+    std::deque<QFuture<QByteArray>> pending;
+    const auto ahead = static_cast<size_t>(qMax(1, pool.maxThreadCount()) * 2);
+    qsizetype written = 0;
+    int percent = 0;
+
+    auto writeFirst = [&]() {
+        const auto data = pending.front().result();
+        pending.pop_front();
+
+        if (data.isEmpty() || !writer.addFrame(data, delays.value(written, 0))) {
+            return false;
+        }
+
+        ++written;
+
+        const auto p = static_cast<int>(written * 100 / count);
+
+        if (p != percent) {
+            percent = p;
+
+            emit writeProgress(percent);
+        }
+
+        return true;
+    };
+
+    for (qsizetype i = 0; i < count; ++i) {
+        // Not committed file is removed.
+        if (promise && promise->isCanceled()) {
+            return finish(false);
+        }
+
+        {
+            QPainter p(&canvas);
+            p.setCompositionMode(QPainter::CompositionMode_Source);
+            p.drawImage(frames.rect(i).topLeft(), frames.take(i, count));
+        }
+
+        pending.push_back(QtConcurrent::run(&pool, [img = canvas]() {
+            return qoiEncode(img);
+        }));
+
+        while (pending.size() >= ahead) {
+            if (!writeFirst()) {
+                return finish(false);
+            }
+        }
+    }
+
+    while (!pending.empty()) {
+        if (!writeFirst()) {
+            return finish(false);
+        }
+    }
+
+    return finish(writer.close(events, keyNames));
+}
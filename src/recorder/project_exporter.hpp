@@ -0,0 +1,55 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QHash>
+#include <QObject>
+#include <QPromise>
+#include <QString>
+#include <QVector>
+
+// shared include.
+#include "project.hpp"
+
+class FrameComposer;
+
+//
+// ProjectExporter
+//
+
+//! Writer of the project for the editor from raw frames. Frames are written whole and
+//! without loss, so quantization happens only once, when the editor exports GIF.
+class ProjectExporter final : public QObject
+{
+    Q_OBJECT
+
+signals:
+    //! Progress of writing in percents.
+    void writeProgress(int percent);
+
+public:
+    explicit ProjectExporter(QObject *parent = nullptr);
+    ~ProjectExporter() override = default;
+
+    //! Write to the shared memory segment for the editor, file name is the name of the segment.
+    void setShared(bool on);
+
+    //! Write all frames composed with overlays, their delays, input events and names of keys.
+    //! Result is added to the promise if it's given.
+    bool write(const QString &fileName,
+               FrameComposer &frames,
+               const QVector<int> &delays,
+               const QVector<ProjectEvent> &events,
+               const QHash<quint32, QString> &keyNames,
+               QPromise<bool> *promise = nullptr);
+
+private:
+    Q_DISABLE_COPY(ProjectExporter)
+
+    //! Write to the shared memory segment.
+    bool m_shared = false;
+}; // class ProjectExporter
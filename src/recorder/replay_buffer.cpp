@@ -0,0 +1,223 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF recorder include.
+#include "replay_buffer.hpp"
+
+// shared include.
+#include "qoi.hpp"
+
+// Qt include.
+#include <QMutexLocker>
+
+// C++ include.
+#include <cstring>
+
+namespace /* anonymous */
+{
+
+//! \return Decompressed \a f.
+QImage decode(const ReplayFrame &f)
+{
+    QImage img(f.m_rect.size(), QImage::Format_RGB32);
+
+    if (!qoiDecode(f.m_data, img)) {
+        return {};
+    }
+
+    return img;
+}
+
+//! Copy 32 bits per pixel \a part into \a img at \a pos.
+void drawPart(QImage &img,
+              const QImage &part,
+              const QPoint &pos)
+{
+    const auto r = QRect(pos, part.size()) & img.rect();
+    const auto bytes = static_cast<size_t>(r.width()) * 4;
+
+    for (int y = r.top(); y <= r.bottom(); ++y) {
+        std::memcpy(reinterpret_cast<QRgb *>(img.scanLine(y)) + r.x(),
+                    reinterpret_cast<const QRgb *>(part.constScanLine(y - pos.y())) + (r.x() - pos.x()),
+                    bytes);
+    }
+}
+
+} /* namespace anonymous */
+
+//
+// ReplaySnapshot
+//
+
+qsizetype ReplaySnapshot::count() const
+{
+    return m_frames.size();
+}
+
+QImage ReplaySnapshot::at(qsizetype idx) const
+{
+    if (idx < 0 || idx >= m_frames.size()) {
+        return {};
+    }
+
+    const auto &f = m_frames[idx];
+    auto img = decode(f);
+
+    if (idx > 0 || img.isNull() || f.m_rect == m_base.rect()) {
+        return img;
+    }
+
+    // The first frame is whole, it's the base with the first changes.
+    auto first = m_base;
+    drawPart(first, img, f.m_rect.topLeft());
+
+    return first;
+}
+
+QSize ReplaySnapshot::size(qsizetype idx) const
+{
+    return rect(idx).size();
+}
+
+QRect ReplaySnapshot::rect(qsizetype idx) const
+{
+    if (idx < 0 || idx >= m_frames.size()) {
+        return {};
+    }
+
+    return (idx == 0 ? m_base.rect() : m_frames[idx].m_rect);
+}
+
+QVector<int> ReplaySnapshot::delays(qint64 end) const
+{
+    QVector<int> ret;
+    ret.reserve(m_frames.size());
+
+    for (qsizetype i = 0; i < m_frames.size(); ++i) {
+        const auto next = (i + 1 < m_frames.size() ? m_frames[i + 1].m_timestamp : qMax(end, m_frames[i].m_timestamp));
+
+        ret.push_back(static_cast<int>(next - m_frames[i].m_timestamp));
+    }
+
+    return ret;
+}
+
+qint64 ReplaySnapshot::timestamp(qsizetype idx) const
+{
+    return (idx >= 0 && idx < m_frames.size() ? m_frames[idx].m_timestamp : 0);
+}
+
+QVector<OverlaySample> ReplaySnapshot::overlays() const
+{
+    QVector<OverlaySample> ret;
+    ret.reserve(m_frames.size());
+
+    for (const auto &f : m_frames) {
+        ret.push_back(f.m_overlay);
+    }
+
+    return ret;
+}
+
+//
+// ReplayBuffer
+//
+
+void ReplayBuffer::reset(const QSize &frameSize,
+                         qint64 duration,
+                         qint64 bytes)
+{
+    QMutexLocker lock(&m_mutex);
+
+    m_frames.clear();
+    m_bytes = 0;
+    m_duration = duration;
+    m_maxBytes = bytes;
+    m_base = QImage(frameSize, QImage::Format_RGB32);
+    m_base.fill(Qt::black);
+}
+
+qint64 ReplayBuffer::append(const QImage &img,
+                            const QRect &rect,
+                            qint64 timestamp,
+                            const OverlaySample &overlay)
+{
+    ReplayFrame f;
+    f.m_rect = rect & img.rect();
+    f.m_timestamp = timestamp;
+    f.m_overlay = overlay;
+
+    // Compressed out of the guard, so snapshots don't wait for it.
+    f.m_data = qoiEncode(img.copy(f.m_rect));
+
+    QMutexLocker lock(&m_mutex);
+
+    m_bytes += f.m_data.size();
+    m_frames.push_back(std::move(f));
+
+    const auto latest = m_frames.back().m_timestamp;
+
+    // The second frame is checked, so the window covers the whole duration.
+    while (m_frames.size() > 1
+           && (m_bytes > m_maxBytes || (m_duration > 0 && m_frames[1].m_timestamp <= latest - m_duration))) {
+        evict();
+    }
+
+    return m_frames.front().m_timestamp;
+}
+
+void ReplayBuffer::evict()
+{
+    const auto &f = m_frames.front();
+    const auto img = decode(f);
+
+    // Snapshots hold the previous base, it's detached here.
+    if (!img.isNull()) {
+        drawPart(m_base, img, f.m_rect.topLeft());
+    }
+
+    m_bytes -= f.m_data.size();
+    m_frames.pop_front();
+}
+
+ReplaySnapshot ReplayBuffer::snapshot() const
+{
+    ReplaySnapshot s;
+
+    QMutexLocker lock(&m_mutex);
+
+    s.m_base = m_base;
+    s.m_frames.reserve(static_cast<qsizetype>(m_frames.size()));
+
+    // Only headers are copied, pixels are shared.
+    for (const auto &f : m_frames) {
+        s.m_frames.push_back(f);
+    }
+
+    return s;
+}
+
+qsizetype ReplayBuffer::count() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return static_cast<qsizetype>(m_frames.size());
+}
+
+qint64 ReplayBuffer::memoryUsage() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return m_bytes + m_base.sizeInBytes();
+}
+
+void ReplayBuffer::clear()
+{
+    QMutexLocker lock(&m_mutex);
+
+    m_frames.clear();
+    m_bytes = 0;
+    m_base = {};
+}
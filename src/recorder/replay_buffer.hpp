@@ -0,0 +1,121 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QByteArray>
+#include <QImage>
+#include <QMutex>
+#include <QRect>
+#include <QVector>
+
+// GIF recorder include.
+#include "frame_source.hpp"
+#include "overlay_track.hpp"
+
+// C++ include.
+#include <deque>
+
+//
+// ReplayFrame
+//
+
+//! Compressed frame of the replay buffer.
+struct ReplayFrame {
+    //! Pixels of the changed part compressed with QOI operations, implicitly shared with snapshots.
+    QByteArray m_data;
+    //! Changed part of the frame.
+    QRect m_rect;
+    //! Time of the grab in milliseconds since start of recording.
+    qint64 m_timestamp = 0;
+    //! Overlays of the frame.
+    OverlaySample m_overlay;
+}; // struct ReplayFrame
+
+//
+// ReplaySnapshot
+//
+
+//! Frames of the replay buffer at some moment. Pixels are shared with the buffer, so
+//! the snapshot is cheap, and it stays valid while the buffer goes on.
+class ReplaySnapshot final : public FrameSource
+{
+public:
+    ReplaySnapshot() = default;
+    ~ReplaySnapshot() override = default;
+
+    qsizetype count() const override;
+    QImage at(qsizetype idx) const override;
+    QSize size(qsizetype idx) const override;
+    QRect rect(qsizetype idx) const override;
+
+    //! \return Delays of frames, the last one lasts till \a end in milliseconds since start of recording.
+    QVector<int> delays(qint64 end) const;
+    //! \return Time of the frame at the given index in milliseconds since start of recording.
+    qint64 timestamp(qsizetype idx) const;
+    //! \return Overlays of frames.
+    QVector<OverlaySample> overlays() const;
+
+private:
+    friend class ReplayBuffer;
+
+    //! Screen before the first frame.
+    QImage m_base;
+    //! Frames.
+    QVector<ReplayFrame> m_frames;
+}; // class ReplaySnapshot
+
+//
+// ReplayBuffer
+//
+
+//! Ring of the last recorded frames compressed in memory. When the ring is over its limits the
+//! oldest frames are drawn onto the base image and dropped, so frames stay changed parts only.
+//! Frames are appended in one thread, snapshots may be taken in any other.
+class ReplayBuffer final
+{
+public:
+    ReplayBuffer() = default;
+
+    //! Start new buffer with black base of \a frameSize, frames are kept for \a duration milliseconds
+    //! and in \a bytes of memory, the latest frame is kept anyway.
+    void reset(const QSize &frameSize,
+               qint64 duration,
+               qint64 bytes);
+    //! Append \a rect of the frame, \a img is the whole frame with only \a rect valid.
+    //! \return Time of the oldest kept frame.
+    qint64 append(const QImage &img,
+                const QRect &rect,
+                qint64 timestamp,
+                const OverlaySample &overlay);
+    //! \return Snapshot of current frames.
+    ReplaySnapshot snapshot() const;
+    //! \return Count of frames.
+    qsizetype count() const;
+    //! \return Bytes of compressed frames and the base.
+    qint64 memoryUsage() const;
+    //! Remove all frames.
+    void clear();
+
+private:
+    Q_DISABLE_COPY(ReplayBuffer)
+
+    //! Draw the oldest frame onto the base and drop it. Should be called under the guard.
+    void evict();
+
+    //! Guard.
+    mutable QMutex m_mutex;
+    //! Screen before the first frame.
+    QImage m_base;
+    //! Frames.
+    std::deque<ReplayFrame> m_frames;
+    //! How long frames are kept, in milliseconds.
+    qint64 m_duration = 0;
+    //! Memory for compressed frames, in bytes.
+    qint64 m_maxBytes = 0;
+    //! Bytes of compressed frames.
+    qint64 m_bytes = 0;
+}; // class ReplayBuffer
@@ -8,6 +8,7 @@
 
 // Qt include.
 #include <QCheckBox>
+#include <QComboBox>
 #include <QSpinBox>
 
 //
@@ -15,18 +16,30 @@
 //
 
 Settings::Settings(int fpsValue,
+                   bool adaptiveFps,
                    bool grabCursorValue,
                    bool drawMouseClicks,
                    bool drawKeyboardKeysPresses,
+                   int memoryBudget,
+                   bool showStats,
+                   int downscale,
+                   int replaySeconds,
+                   PaletteMode paletteMode,
                    QWidget *parent)
     : QDialog(parent)
 {
     m_ui.setupUi(this);
 
     m_ui.m_fps->setValue(fpsValue);
+    m_ui.m_adaptive->setChecked(adaptiveFps);
     m_ui.m_cursor->setChecked(grabCursorValue);
     m_ui.m_click->setChecked(drawMouseClicks);
     m_ui.m_key->setChecked(drawKeyboardKeysPresses);
+    m_ui.m_memory->setValue(memoryBudget);
+    m_ui.m_stats->setChecked(showStats);
+    m_ui.m_downscale->setValue(downscale);
+    m_ui.m_replay->setValue(replaySeconds);
+    m_ui.m_palette->setCurrentIndex(static_cast<int>(paletteMode));
 }
 
 int Settings::fps() const
@@ -34,6 +47,11 @@ int Settings::fps() const
     return m_ui.m_fps->value();
 }
 
+bool Settings::adaptiveFps() const
+{
+    return m_ui.m_adaptive->isChecked();
+}
+
 bool Settings::grabCursor() const
 {
     return m_ui.m_cursor->isChecked();
@@ -48,3 +66,28 @@ bool Settings::drawKeyboardKeysPresses() const
 {
     return m_ui.m_key->isChecked();
 }
+
+int Settings::memoryBudget() const
+{
+    return m_ui.m_memory->value();
+}
+
+bool Settings::showStats() const
+{
+    return m_ui.m_stats->isChecked();
+}
+
+int Settings::downscale() const
+{
+    return m_ui.m_downscale->value();
+}
+
+int Settings::replaySeconds() const
+{
+    return m_ui.m_replay->value();
+}
+
+PaletteMode Settings::paletteMode() const
+{
+    return static_cast<PaletteMode>(m_ui.m_palette->currentIndex());
+}
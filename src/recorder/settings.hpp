@@ -9,6 +9,7 @@
 #include <QDialog>
 
 // GIF recorder include.
+#include "gif_writer.hpp"
 #include "ui_settings.h"
 
 //
@@ -22,16 +23,34 @@ class Settings : public QDialog
 
 public:
     Settings(int fpsValue,
+             bool adaptiveFps,
              bool grabCursorValue,
              bool drawMouseClicks,
              bool drawKeyboardKeysPresses,
+             int memoryBudget,
+             bool showStats,
+             int downscale,
+             int replaySeconds,
+             PaletteMode paletteMode,
              QWidget *parent);
     ~Settings() override = default;
 
     int fps() const;
+    //! \return Is frame rate adaptive.
+    bool adaptiveFps() const;
     bool grabCursor() const;
     bool drawMouseClicks() const;
     bool drawKeyboardKeysPresses() const;
+    //! \return Memory for frames, in megabytes.
+    int memoryBudget() const;
+    //! \return Show live statistics while recording.
+    bool showStats() const;
+    //! \return How many times frames are reduced.
+    int downscale() const;
+    //! \return Seconds kept in replay mode, 0 if it's off.
+    int replaySeconds() const;
+    //! \return Mode of palettes of GIF.
+    PaletteMode paletteMode() const;
 
 private:
     Q_DISABLE_COPY(Settings)
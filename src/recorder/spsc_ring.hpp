@@ -0,0 +1,71 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QtGlobal>
+
+// C++ include.
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+//
+// SpscRing
+//
+
+//! Lock-free fixed-capacity FIFO of trivially copyable values for one producer and
+//! one consumer. Never blocks and never allocates.
+template<class T, std::size_t Capacity>
+class SpscRing final
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Values should be trivially copyable.");
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity should be a power of two.");
+
+public:
+    SpscRing() = default;
+
+    //! Push value, should be called by producer only. \return false if the ring is full.
+    bool push(const T &value)
+    {
+        const auto head = m_head.load(std::memory_order_relaxed);
+
+        if (head - m_tail.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+
+        m_values[head & (Capacity - 1)] = value;
+        m_head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    //! Pop value, should be called by consumer only. \return false if the ring is empty.
+    bool pop(T &value)
+    {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail == m_head.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        value = m_values[tail & (Capacity - 1)];
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+private:
+    Q_DISABLE_COPY(SpscRing)
+
+    //! Values.
+    std::array<T, Capacity> m_values = {};
+    //! Count of pushed values, written by producer only.
+    alignas(64) std::atomic<std::size_t> m_head{0};
+    //! Count of popped values, written by consumer only.
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+}; // class SpscRing
@@ -0,0 +1,254 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// GIF recorder include.
+#include "stream_encoder.hpp"
+#include "frame_store.hpp"
+
+// Qt include.
+#include <QDir>
+#include <QFile>
+#include <QMutexLocker>
+#include <QTemporaryFile>
+
+// C++ include.
+#include <filesystem>
+#include <system_error>
+
+//! How often saving checks encoding, in milliseconds.
+static const int s_saveCheckInterval = 100;
+
+//
+// StreamEncoder
+//
+
+StreamEncoder::StreamEncoder(const FrameStore &frames,
+                             const OverlayTrack &track,
+                             QObject *parent)
+    : QThread(parent)
+    , m_frames(frames, track)
+{
+}
+
+StreamEncoder::~StreamEncoder()
+{
+    discard();
+}
+
+bool StreamEncoder::begin(const QSize &size,
+                          const OverlayOptions &options,
+                          PaletteMode mode)
+{
+    discard();
+
+    m_frames.setOptions(options);
+    // Frames come one at a time, so palette of all of them isn't known.
+    m_writer.setPaletteMode(mode == PaletteMode::Global ? PaletteMode::Stable : mode);
+
+    m_partial.reset(new QTemporaryFile(QDir::tempPath() + QDir::separator()
+                                       + QStringLiteral("gif-recorder-XXXXXX.gif.part")));
+
+    if (!m_partial->open()) {
+        m_partial.reset();
+
+        return false;
+    }
+
+    // File keeps its name till destruction, writer opens it by itself.
+    m_partial->close();
+
+    if (!m_writer.open(m_partial->fileName(), size)) {
+        m_partial.reset();
+
+        return false;
+    }
+
+    m_timestamps.clear();
+    m_end = 0;
+    m_finished = false;
+    m_canceled = false;
+    m_encoded = 0;
+    m_failed = false;
+
+    start();
+
+    return true;
+}
+
+OverlayOptions StreamEncoder::options() const
+{
+    return m_frames.options();
+}
+
+bool StreamEncoder::isActive() const
+{
+    return (m_partial && !m_failed.load());
+}
+
+void StreamEncoder::addFrame(qint64 timestamp)
+{
+    QMutexLocker lock(&m_mutex);
+
+    m_timestamps.push_back(timestamp);
+
+    m_cond.wakeAll();
+}
+
+void StreamEncoder::finish(qint64 timestamp)
+{
+    QMutexLocker lock(&m_mutex);
+
+    m_end = timestamp;
+    m_finished = true;
+
+    m_cond.wakeAll();
+}
+
+bool StreamEncoder::save(const QString &fileName,
+                         QPromise<bool> *promise)
+{
+    auto result = [promise](bool ok) {
+        if (promise) {
+            promise->addResult(ok);
+        }
+
+        return ok;
+    };
+
+    qsizetype total = 0;
+
+    {
+        QMutexLocker lock(&m_mutex);
+
+        total = m_timestamps.size();
+    }
+
+    if (!m_partial || total == 0) {
+        discard();
+
+        return result(false);
+    }
+
+    int percent = -1;
+
+    while (!wait(s_saveCheckInterval)) {
+        if (promise && promise->isCanceled()) {
+            discard();
+
+            return result(false);
+        }
+
+        const auto p = static_cast<int>(m_encoded.load() * 100 / total);
+
+        if (p != percent) {
+            percent = p;
+
+            emit writeProgress(percent);
+        }
+    }
+
+    if (m_failed) {
+        discard();
+
+        return result(false);
+    }
+
+    emit writeProgress(100);
+
+    // Copies if the file is on another file system, so it goes besides the target first and the
+    // existing file is replaced only with the complete one. Encoded file is kept on failure,
+    // saving may be tried again.
+    const auto next = fileName + QStringLiteral(".part");
+
+    QFile::remove(next);
+
+    if (!QFile::rename(m_partial->fileName(), next)) {
+        QFile::remove(next);
+
+        return result(false);
+    }
+
+    std::error_code error;
+    std::filesystem::rename(std::filesystem::path(next.toStdU16String()),
+                            std::filesystem::path(fileName.toStdU16String()),
+                            error);
+
+    if (error) {
+        QFile::rename(next, m_partial->fileName());
+
+        return result(false);
+    }
+
+    m_partial.reset();
+
+    return result(true);
+}
+
+void StreamEncoder::discard()
+{
+    {
+        QMutexLocker lock(&m_mutex);
+
+        m_canceled = true;
+
+        m_cond.wakeAll();
+    }
+
+    wait();
+
+    m_writer.close();
+    m_partial.reset();
+}
+
+qsizetype StreamEncoder::backlog() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    return m_timestamps.size() - m_encoded.load();
+}
+
+void StreamEncoder::run()
+{
+    qsizetype idx = 0;
+
+    while (true) {
+        qint64 delay = 0;
+        qsizetype available = 0;
+
+        {
+            QMutexLocker lock(&m_mutex);
+
+            // Delay of the frame is known only when the next one comes.
+            while (!m_canceled && !m_finished && idx + 1 >= m_timestamps.size()) {
+                m_cond.wait(&m_mutex);
+            }
+
+            if (m_canceled || idx >= m_timestamps.size()) {
+                break;
+            }
+
+            const auto next = (idx + 1 < m_timestamps.size() ? m_timestamps[idx + 1] : m_end);
+            delay = next - m_timestamps[idx];
+            available = m_timestamps.size();
+        }
+
+        // Frames after this one are composed with overlays in parallel meanwhile.
+        const auto frame = m_frames.take(idx, available);
+
+        if (!m_writer.writeFrame(frame, static_cast<int>(delay), m_frames.rect(idx).topLeft())) {
+            m_failed = true;
+
+            break;
+        }
+
+        m_encoded = ++idx;
+    }
+
+    m_frames.reset();
+
+    if (!m_writer.close()) {
+        m_failed = true;
+    }
+}
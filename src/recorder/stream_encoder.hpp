@@ -0,0 +1,98 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QMutex>
+#include <QPromise>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+
+// C++ include.
+#include <atomic>
+#include <memory>
+
+// GIF recorder include.
+#include "frame_composer.hpp"
+#include "gif_writer.hpp"
+
+class FrameStore;
+class QTemporaryFile;
+
+//
+// StreamEncoder
+//
+
+//! Encoder of GIF that runs during recording. Frames are encoded as soon as
+//! their delay is known and appended to a partially written file, so saving
+//! only finishes the last frame and moves the file.
+class StreamEncoder final : public QThread
+{
+    Q_OBJECT
+
+signals:
+    //! Progress of saving in percents.
+    void writeProgress(int percent);
+
+public:
+    StreamEncoder(const FrameStore &frames,
+                  const OverlayTrack &track,
+                  QObject *parent = nullptr);
+    ~StreamEncoder() override;
+
+    //! Open partial file for frames of \a size and start encoding with overlays \a options
+    //! and palettes of \a mode. \return false if the file can't be written.
+    bool begin(const QSize &size,
+               const OverlayOptions &options,
+               PaletteMode mode = PaletteMode::Stable);
+    //! \return Options of overlays the frames are encoded with.
+    OverlayOptions options() const;
+    //! \return Is encoding started and not failed.
+    bool isActive() const;
+    //! Next frame of the store was grabbed at \a timestamp, in milliseconds.
+    void addFrame(qint64 timestamp);
+    //! There will be no more frames, the last one lasts till \a timestamp.
+    void finish(qint64 timestamp);
+    //! Wait for all frames, write trailer and move the file to \a fileName. Existing file is replaced
+    //! only on success, on failure encoded file is kept. Result is added to the promise if it's given.
+    bool save(const QString &fileName,
+              QPromise<bool> *promise = nullptr);
+    //! Stop encoding and remove the partial file.
+    void discard();
+
+    //! \return Count of frames waiting for encoding.
+    qsizetype backlog() const;
+
+protected:
+    void run() override;
+
+private:
+    Q_DISABLE_COPY(StreamEncoder)
+
+    //! Frames with overlays.
+    FrameComposer m_frames;
+    //! Writer.
+    GifWriter m_writer;
+    //! Partial file.
+    std::unique_ptr<QTemporaryFile> m_partial;
+    //! Guard.
+    mutable QMutex m_mutex;
+    //! Signals about new frames.
+    QWaitCondition m_cond;
+    //! Timestamps of frames.
+    QVector<qint64> m_timestamps;
+    //! Time of the end of the last frame.
+    qint64 m_end = 0;
+    //! No more frames will come.
+    bool m_finished = false;
+    //! Encoding should be stopped.
+    bool m_canceled = false;
+    //! Count of encoded frames.
+    std::atomic<qsizetype> m_encoded{0};
+    //! Encoding failed.
+    std::atomic_bool m_failed{false};
+}; // class StreamEncoder
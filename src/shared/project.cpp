@@ -0,0 +1,507 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// shared include.
+#include "project.hpp"
+#include "qoi.hpp"
+
+// Qt include.
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QRandomGenerator>
+
+#ifdef Q_OS_LINUX
+// C include.
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace /* anonymous */
+{
+
+//! Signature at the beginning and at the end of the file.
+const QByteArray s_magic = QByteArrayLiteral("GIFTPROJ");
+//! Version of the format.
+const quint32 s_version = 1;
+//! Size of the header: signature, version, width and height.
+const qint64 s_headerSize = 8 + 4 + 4 + 4;
+//! Size of the trailer: offset of the index and signature.
+const qint64 s_trailerSize = 8 + 8;
+//! The biggest side of frames, anything above is a corrupted file.
+const quint32 s_maxSide = 32768;
+
+#ifdef Q_OS_LINUX
+//! \return Descriptor of the shared memory segment, -1 on error.
+int openSegment(const QString &name,
+                int flags)
+{
+    return ::shm_open(QFile::encodeName(name).constData(), flags, S_IRUSR | S_IWUSR);
+}
+#endif
+
+//! Prepare \a s for reading or writing the project.
+void setup(QDataStream &s)
+{
+    s.setByteOrder(QDataStream::LittleEndian);
+    s.setVersion(QDataStream::Qt_6_0);
+}
+
+} /* namespace anonymous */
+
+QString projectSuffix()
+{
+    return QStringLiteral("gifproj");
+}
+
+QString sharedProjectName()
+{
+    return QStringLiteral("/gif-recorder-%1-%2")
+        .arg(QCoreApplication::applicationPid())
+        .arg(QRandomGenerator::global()->generate(), 8, 16, QLatin1Char('0'));
+}
+
+void removeSharedProject(const QString &name)
+{
+#ifdef Q_OS_LINUX
+    ::shm_unlink(QFile::encodeName(name).constData());
+#else
+    Q_UNUSED(name)
+#endif
+}
+
+//
+// ProjectWriter
+//
+
+ProjectWriter::~ProjectWriter()
+{
+    if (m_device) {
+        cancel();
+        close();
+    }
+}
+
+bool ProjectWriter::open(const QString &fileName,
+                         const QSize &size)
+{
+    // Previous file is discarded if it wasn't closed.
+    if (m_device) {
+        cancel();
+        close();
+    }
+
+    m_file.setFileName(fileName);
+    m_size = size;
+    m_index.clear();
+    m_failed = false;
+
+    if (size.isEmpty() || !m_file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    m_device = &m_file;
+
+    return writeHeader();
+}
+
+bool ProjectWriter::openShared(const QString &name,
+                               const QSize &size)
+{
+    if (m_device) {
+        cancel();
+        close();
+    }
+
+    m_size = size;
+    m_index.clear();
+    m_failed = false;
+
+#ifdef Q_OS_LINUX
+    if (size.isEmpty()) {
+        return false;
+    }
+
+    const auto fd = openSegment(name, O_RDWR | O_CREAT | O_EXCL);
+
+    if (fd == -1) {
+        return false;
+    }
+
+    m_sharedName = name;
+
+    // Segment of tmpfs grows on writes like a file, so frames are written as they are ready.
+    if (!m_shared.open(fd, QIODevice::WriteOnly, QFileDevice::AutoCloseHandle)) {
+        ::close(fd);
+        removeSharedProject(name);
+        m_sharedName.clear();
+
+        return false;
+    }
+
+    m_device = &m_shared;
+
+    return writeHeader();
+#else
+    Q_UNUSED(name)
+
+    return false;
+#endif
+}
+
+bool ProjectWriter::writeHeader()
+{
+    QDataStream s(m_device);
+    setup(s);
+
+    s.writeRawData(s_magic.constData(), s_magic.size());
+    s << s_version << static_cast<quint32>(m_size.width()) << static_cast<quint32>(m_size.height());
+
+    if (s.status() != QDataStream::Ok) {
+        cancel();
+        close();
+
+        return false;
+    }
+
+    return true;
+}
+
+void ProjectWriter::cancel()
+{
+    m_failed = true;
+
+    if (m_device == &m_file) {
+        m_file.cancelWriting();
+    }
+}
+
+bool ProjectWriter::addFrame(const QByteArray &data,
+                             int delay)
+{
+    if (!m_device || m_failed) {
+        return false;
+    }
+
+    Entry e;
+    e.m_offset = m_device->pos();
+    e.m_bytes = data.size();
+    e.m_delay = delay;
+
+    // Failed file is discarded on close().
+    if (m_device->write(data) != data.size()) {
+        cancel();
+
+        return false;
+    }
+
+    m_index.push_back(e);
+
+    return true;
+}
+
+bool ProjectWriter::close(const QVector<ProjectEvent> &events,
+                          const QHash<quint32, QString> &keyNames)
+{
+    if (!m_device) {
+        return false;
+    }
+
+    const auto indexOffset = m_device->pos();
+
+    QDataStream s(m_device);
+    setup(s);
+
+    s << static_cast<quint32>(m_index.size());
+
+    for (const auto &e : std::as_const(m_index)) {
+        s << static_cast<quint64>(e.m_offset) << static_cast<quint32>(e.m_bytes) << static_cast<qint32>(e.m_delay);
+    }
+
+    s << static_cast<quint32>(events.size());
+
+    for (const auto &e : events) {
+        s << static_cast<qint64>(e.m_timestamp) << e.m_key << static_cast<quint8>(e.m_type) << e.m_button;
+    }
+
+    s << static_cast<quint32>(keyNames.size());
+
+    for (auto it = keyNames.cbegin(), last = keyNames.cend(); it != last; ++it) {
+        s << it.key() << it.value();
+    }
+
+    s << static_cast<quint64>(indexOffset);
+    s.writeRawData(s_magic.constData(), s_magic.size());
+
+    m_index.clear();
+
+    if (s.status() != QDataStream::Ok) {
+        cancel();
+    }
+
+    const auto device = m_device;
+    m_device = nullptr;
+
+    if (device == &m_file) {
+        return m_file.commit();
+    }
+
+    const auto ok = (m_shared.flush() && !m_failed);
+
+    m_shared.close();
+
+    if (!ok) {
+        removeSharedProject(m_sharedName);
+    }
+
+    m_sharedName.clear();
+
+    return ok;
+}
+
+//
+// ProjectReader
+//
+
+bool ProjectReader::isProject(const QString &fileName)
+{
+    QFile file(fileName);
+
+    return (file.open(QIODevice::ReadOnly) && file.read(s_magic.size()) == s_magic);
+}
+
+bool ProjectReader::open(const QString &fileName)
+{
+    close();
+
+    m_file.setFileName(fileName);
+
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    return read();
+}
+
+bool ProjectReader::openShared(const QString &name)
+{
+    close();
+
+#ifdef Q_OS_LINUX
+    const auto fd = openSegment(name, O_RDONLY);
+
+    if (fd == -1) {
+        return false;
+    }
+
+    // Nobody else needs the segment, memory is freed when it's unmapped.
+    removeSharedProject(name);
+
+    if (!m_file.open(fd, QIODevice::ReadOnly, QFileDevice::AutoCloseHandle)) {
+        ::close(fd);
+
+        return false;
+    }
+
+    return read();
+#else
+    Q_UNUSED(name)
+
+    return false;
+#endif
+}
+
+bool ProjectReader::read()
+{
+    if (m_file.size() < s_headerSize + s_trailerSize) {
+        close();
+
+        return false;
+    }
+
+    QDataStream s(&m_file);
+    setup(s);
+
+    QByteArray magic(s_magic.size(), Qt::Uninitialized);
+    quint32 version = 0;
+    quint32 width = 0;
+    quint32 height = 0;
+
+    s.readRawData(magic.data(), magic.size());
+    s >> version >> width >> height;
+
+    if (magic != s_magic || version != s_version || width == 0 || height == 0 || width > s_maxSide
+        || height > s_maxSide) {
+        close();
+
+        return false;
+    }
+
+    m_size = QSize(static_cast<int>(width), static_cast<int>(height));
+
+    quint64 indexOffset = 0;
+
+    m_file.seek(m_file.size() - s_trailerSize);
+    s >> indexOffset;
+    s.readRawData(magic.data(), magic.size());
+
+    if (magic != s_magic || indexOffset < static_cast<quint64>(s_headerSize)
+        || indexOffset > static_cast<quint64>(m_file.size() - s_trailerSize)) {
+        close();
+
+        return false;
+    }
+
+    m_file.seek(static_cast<qint64>(indexOffset));
+
+    quint32 count = 0;
+    s >> count;
+
+    // Every entry takes 16 bytes, so the count can't be bigger than the rest of the file.
+    if (count > (m_file.size() - static_cast<qint64>(indexOffset)) / 16) {
+        close();
+
+        return false;
+    }
+
+    m_index.reserve(count);
+
+    for (quint32 i = 0; i < count; ++i) {
+        quint64 offset = 0;
+        quint32 bytes = 0;
+        qint32 delay = 0;
+
+        s >> offset >> bytes >> delay;
+
+        // Sum of offset and size may overflow, so they are checked separately.
+        if (offset < static_cast<quint64>(s_headerSize) || offset > indexOffset || bytes > indexOffset - offset) {
+            close();
+
+            return false;
+        }
+
+        m_index.push_back({static_cast<qint64>(offset), static_cast<qint64>(bytes), delay});
+    }
+
+    quint32 eventsCount = 0;
+    s >> eventsCount;
+
+    for (quint32 i = 0; i < eventsCount && s.status() == QDataStream::Ok; ++i) {
+        ProjectEvent e;
+        quint8 type = 0;
+
+        s >> e.m_timestamp >> e.m_key >> type >> e.m_button;
+        e.m_type = static_cast<ProjectEvent::Type>(type);
+
+        m_events.push_back(e);
+    }
+
+    quint32 keysCount = 0;
+    s >> keysCount;
+
+    for (quint32 i = 0; i < keysCount && s.status() == QDataStream::Ok; ++i) {
+        quint32 key = 0;
+        QString name;
+
+        s >> key >> name;
+
+        m_keyNames.insert(key, name);
+    }
+
+    if (s.status() != QDataStream::Ok) {
+        close();
+
+        return false;
+    }
+
+    // Without the map frames are read under no guard, so the project can't be used.
+    m_map = m_file.map(0, m_file.size());
+
+    if (!m_map) {
+        close();
+
+        return false;
+    }
+
+    return true;
+}
+
+void ProjectReader::close()
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+
+    m_file.close();
+    m_size = {};
+    m_index.clear();
+    m_events.clear();
+    m_keyNames.clear();
+}
+
+bool ProjectReader::isOpen() const
+{
+    return (m_map != nullptr);
+}
+
+QSize ProjectReader::size() const
+{
+    return m_size;
+}
+
+qsizetype ProjectReader::count() const
+{
+    return m_index.size();
+}
+
+int ProjectReader::delay(qsizetype idx) const
+{
+    return (idx >= 0 && idx < m_index.size() ? m_index[idx].m_delay : 0);
+}
+
+qint64 ProjectReader::offset(qsizetype idx) const
+{
+    return (idx >= 0 && idx < m_index.size() ? m_index[idx].m_offset : -1);
+}
+
+QByteArray ProjectReader::data(qsizetype idx) const
+{
+    if (!m_map || idx < 0 || idx >= m_index.size()) {
+        return {};
+    }
+
+    const auto &e = m_index[idx];
+
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(m_map + e.m_offset), e.m_bytes);
+}
+
+QImage ProjectReader::frame(qsizetype idx) const
+{
+    const auto data = this->data(idx);
+
+    if (data.isEmpty()) {
+        return {};
+    }
+
+    QImage img(m_size, QImage::Format_RGB32);
+
+    if (!qoiDecode(data, img)) {
+        return {};
+    }
+
+    return img;
+}
+
+const QVector<ProjectEvent> &ProjectReader::events() const
+{
+    return m_events;
+}
+
+const QHash<quint32, QString> &ProjectReader::keyNames() const
+{
+    return m_keyNames;
+}
@@ -0,0 +1,181 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QImage>
+#include <QSaveFile>
+#include <QSize>
+#include <QString>
+#include <QVector>
+
+//! \return Suffix of project files, without dot.
+QString projectSuffix();
+//! \return Unique name of the shared memory segment for the project passed to the editor.
+QString sharedProjectName();
+//! Remove the shared memory segment, if the editor didn't take it.
+void removeSharedProject(const QString &name);
+
+//
+// ProjectEvent
+//
+
+//! Input event of the project.
+struct ProjectEvent {
+    //! Type of the event.
+    enum Type : quint8 {
+        ButtonPress,
+        ButtonRelease,
+        KeyPress,
+        KeyRelease
+    }; // enum Type
+
+    //! Time of the event in milliseconds since start of recording.
+    qint64 m_timestamp = 0;
+    //! Native key.
+    quint32 m_key = 0;
+    //! Type.
+    Type m_type = ButtonPress;
+    //! Mouse button.
+    quint8 m_button = 0;
+}; // struct ProjectEvent
+
+//
+// ProjectWriter
+//
+
+//! Writer of the recorder project: whole frames compressed without loss with QOI operations,
+//! their delays, input events and names of keys. Frames go one after another, the index
+//! is written at the end, so frames are written as they are ready. Project is written
+//! to the file or to the POSIX shared memory segment, which the editor maps without copies.
+class ProjectWriter final
+{
+public:
+    ProjectWriter() = default;
+    //! Not closed project is discarded.
+    ~ProjectWriter();
+
+    //! Open file for frames of \a size.
+    bool open(const QString &fileName,
+              const QSize &size);
+    //! Create shared memory segment with the given name for frames of \a size.
+    bool openShared(const QString &name,
+                    const QSize &size);
+    //! Append frame compressed with qoiEncode() with delay in milliseconds.
+    bool addFrame(const QByteArray &data,
+                  int delay);
+    //! Write index, events and names of keys and commit the file. Failed segment is removed.
+    bool close(const QVector<ProjectEvent> &events = {},
+               const QHash<quint32, QString> &keyNames = {});
+
+private:
+    Q_DISABLE_COPY(ProjectWriter)
+
+    //! Write header. \return false on error.
+    bool writeHeader();
+    //! Discard written data.
+    void cancel();
+
+    //! Entry of the index.
+    struct Entry {
+        //! Offset of the frame in the file.
+        qint64 m_offset = 0;
+        //! Size of the compressed frame.
+        qint64 m_bytes = 0;
+        //! Delay in milliseconds.
+        int m_delay = 0;
+    }; // struct Entry
+
+    //! File, it replaces the target only when everything is written.
+    QSaveFile m_file;
+    //! Shared memory segment.
+    QFile m_shared;
+    //! Name of the shared memory segment.
+    QString m_sharedName;
+    //! Device written to, the file or the segment.
+    QFileDevice *m_device = nullptr;
+    //! Is writing failed.
+    bool m_failed = false;
+    //! Size of frames.
+    QSize m_size;
+    //! Index.
+    QVector<Entry> m_index;
+}; // class ProjectWriter
+
+//
+// ProjectReader
+//
+
+//! Reader of the recorder project. Frames are read from the memory-mapped file with random access.
+//! Frames may be read from any thread.
+class ProjectReader final
+{
+public:
+    ProjectReader() = default;
+    ~ProjectReader() = default;
+
+    //! \return Is the file a project.
+    static bool isProject(const QString &fileName);
+
+    //! Open project. \return false if it's not a project or it's corrupted.
+    bool open(const QString &fileName);
+    //! Open project from the shared memory segment of the recorder. Segment is removed
+    //! at once, so it lives only while it's mapped. \return false if it's not a project.
+    bool openShared(const QString &name);
+    //! Close project.
+    void close();
+    //! \return Is project opened.
+    bool isOpen() const;
+
+    //! \return Size of frames.
+    QSize size() const;
+    //! \return Count of frames.
+    qsizetype count() const;
+    //! \return Delay of frame at the given index, in milliseconds.
+    int delay(qsizetype idx) const;
+    //! \return Offset of frame at the given index in the file.
+    qint64 offset(qsizetype idx) const;
+    //! \return Compressed frame at the given index, data isn't copied from the mapped file.
+    QByteArray data(qsizetype idx) const;
+    //! \return Frame at the given index, null if it's corrupted.
+    QImage frame(qsizetype idx) const;
+    //! \return Input events.
+    const QVector<ProjectEvent> &events() const;
+    //! \return Names of keys.
+    const QHash<quint32, QString> &keyNames() const;
+
+private:
+    Q_DISABLE_COPY(ProjectReader)
+
+    //! Read index of the opened file and map it. \return false if it's corrupted.
+    bool read();
+
+    //! Entry of the index.
+    struct Entry {
+        //! Offset of the frame in the file.
+        qint64 m_offset = 0;
+        //! Size of the compressed frame.
+        qint64 m_bytes = 0;
+        //! Delay in milliseconds.
+        int m_delay = 0;
+    }; // struct Entry
+
+    //! File.
+    QFile m_file;
+    //! Mapped file, frames are read through it without locks.
+    uchar *m_map = nullptr;
+    //! Size of frames.
+    QSize m_size;
+    //! Index.
+    QVector<Entry> m_index;
+    //! Input events.
+    QVector<ProjectEvent> m_events;
+    //! Names of keys.
+    QHash<quint32, QString> m_keyNames;
+}; // class ProjectReader
@@ -0,0 +1,178 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// shared include.
+#include "qoi.hpp"
+
+// C++ include.
+#include <array>
+
+namespace /* anonymous */
+{
+
+const uchar s_opIndex = 0x00;
+const uchar s_opDiff = 0x40;
+const uchar s_opLuma = 0x80;
+const uchar s_opRun = 0xC0;
+const uchar s_opRgb = 0xFE;
+const uchar s_opRgba = 0xFF;
+const uchar s_mask = 0xC0;
+
+//! Longest run of one op.
+const int s_maxRun = 62;
+
+inline int hashOf(QRgb px)
+{
+    return (qRed(px) * 3 + qGreen(px) * 5 + qBlue(px) * 7 + qAlpha(px) * 11) % 64;
+}
+
+} /* namespace anonymous */
+
+QByteArray qoiEncode(const QImage &img)
+{
+    QByteArray data;
+    // Worst case is 5 bytes per pixel, usually it's much less.
+    data.reserve(static_cast<qsizetype>(img.width()) * img.height());
+
+    std::array<QRgb, 64> index = {};
+    QRgb prev = qRgba(0, 0, 0, 255);
+    int run = 0;
+
+    auto flushRun = [&]() {
+        if (run > 0) {
+            data.append(static_cast<char>(s_opRun | (run - 1)));
+            run = 0;
+        }
+    };
+
+    for (int y = 0; y < img.height(); ++y) {
+        const auto line = reinterpret_cast<const QRgb *>(img.constScanLine(y));
+
+        for (int x = 0; x < img.width(); ++x) {
+            const auto px = line[x];
+
+            if (px == prev) {
+                if (++run == s_maxRun) {
+                    flushRun();
+                }
+
+                continue;
+            }
+
+            flushRun();
+
+            const auto h = hashOf(px);
+
+            if (index[h] == px) {
+                data.append(static_cast<char>(s_opIndex | h));
+            } else {
+                index[h] = px;
+
+                if (qAlpha(px) == qAlpha(prev)) {
+                    const auto vr = static_cast<signed char>(qRed(px) - qRed(prev));
+                    const auto vg = static_cast<signed char>(qGreen(px) - qGreen(prev));
+                    const auto vb = static_cast<signed char>(qBlue(px) - qBlue(prev));
+                    const auto vgr = static_cast<signed char>(vr - vg);
+                    const auto vgb = static_cast<signed char>(vb - vg);
+
+                    if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2) {
+                        data.append(static_cast<char>(s_opDiff | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2)));
+                    } else if (vgr > -9 && vgr < 8 && vg > -33 && vg < 32 && vgb > -9 && vgb < 8) {
+                        data.append(static_cast<char>(s_opLuma | (vg + 32)));
+                        data.append(static_cast<char>((vgr + 8) << 4 | (vgb + 8)));
+                    } else {
+                        data.append(static_cast<char>(s_opRgb));
+                        data.append(static_cast<char>(qRed(px)));
+                        data.append(static_cast<char>(qGreen(px)));
+                        data.append(static_cast<char>(qBlue(px)));
+                    }
+                } else {
+                    data.append(static_cast<char>(s_opRgba));
+                    data.append(static_cast<char>(qRed(px)));
+                    data.append(static_cast<char>(qGreen(px)));
+                    data.append(static_cast<char>(qBlue(px)));
+                    data.append(static_cast<char>(qAlpha(px)));
+                }
+            }
+
+            prev = px;
+        }
+    }
+
+    flushRun();
+
+    return data;
+}
+
+bool qoiDecode(const QByteArray &data,
+               QImage &img)
+{
+    const auto bytes = reinterpret_cast<const uchar *>(data.constData());
+    const auto size = data.size();
+    qsizetype p = 0;
+
+    std::array<QRgb, 64> index = {};
+    QRgb px = qRgba(0, 0, 0, 255);
+    int run = 0;
+
+    for (int y = 0; y < img.height(); ++y) {
+        auto line = reinterpret_cast<QRgb *>(img.scanLine(y));
+
+        for (int x = 0; x < img.width(); ++x) {
+            if (run > 0) {
+                --run;
+            } else {
+                if (p >= size) {
+                    return false;
+                }
+
+                const auto b1 = bytes[p++];
+
+                if (b1 == s_opRgb) {
+                    if (p + 3 > size) {
+                        return false;
+                    }
+
+                    px = qRgba(bytes[p], bytes[p + 1], bytes[p + 2], qAlpha(px));
+                    p += 3;
+                } else if (b1 == s_opRgba) {
+                    if (p + 4 > size) {
+                        return false;
+                    }
+
+                    px = qRgba(bytes[p], bytes[p + 1], bytes[p + 2], bytes[p + 3]);
+                    p += 4;
+                } else if ((b1 & s_mask) == s_opIndex) {
+                    px = index[b1];
+                } else if ((b1 & s_mask) == s_opDiff) {
+                    px = qRgba((qRed(px) + ((b1 >> 4) & 0x03) - 2) & 0xFF,
+                               (qGreen(px) + ((b1 >> 2) & 0x03) - 2) & 0xFF,
+                               (qBlue(px) + (b1 & 0x03) - 2) & 0xFF,
+                               qAlpha(px));
+                } else if ((b1 & s_mask) == s_opLuma) {
+                    if (p >= size) {
+                        return false;
+                    }
+
+                    const auto b2 = bytes[p++];
+                    const int vg = (b1 & 0x3F) - 32;
+
+                    px = qRgba((qRed(px) + vg - 8 + ((b2 >> 4) & 0x0F)) & 0xFF,
+                               (qGreen(px) + vg) & 0xFF,
+                               (qBlue(px) + vg - 8 + (b2 & 0x0F)) & 0xFF,
+                               qAlpha(px));
+                } else {
+                    run = (b1 & 0x3F);
+                }
+
+                index[hashOf(px)] = px;
+            }
+
+            line[x] = px;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,19 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#pragma once
+
+// Qt include.
+#include <QByteArray>
+#include <QImage>
+
+//! \return Pixels of the 32 bits per pixel \a img compressed with QOI operations.
+//! Header is not written, size and format should be stored by the caller.
+QByteArray qoiEncode(const QImage &img);
+
+//! Decompress \a data made by qoiEncode() into the preallocated 32 bits per pixel \a img.
+//! \return false if data is corrupted.
+bool qoiDecode(const QByteArray &data,
+               QImage &img);